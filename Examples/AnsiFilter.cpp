@@ -0,0 +1,37 @@
+// Strips ANSI escape codes from stdin, or converts colors to HTML.
+//
+// Build: g++ -std=c++17 -O2 AnsiFilter.cpp -o ansifilter
+// Usage: ./my_tool | ./ansifilter          (plain text)
+//        ./my_tool | ./ansifilter --html   (HTML with colored spans)
+#include "../src/CLIKitAnsiFilter.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+int main(int argc, char** argv) {
+	CLIKit::AnsiFilterMode mode = CLIKit::AnsiFilterMode::Strip;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--html") == 0) {
+			mode = CLIKit::AnsiFilterMode::Html;
+		}
+		else {
+			std::fprintf(stderr, "usage: %s [--html] < input > output\n", argv[0]);
+			return 1;
+		}
+	}
+
+	CLIKit::AnsiFilter filter(mode);
+	auto sink = [](const char* data, size_t size) { std::fwrite(data, 1, size, stdout); };
+
+	if (mode == CLIKit::AnsiFilterMode::Html) std::fputs("<pre>", stdout);
+
+	std::vector<char> chunk(1 << 16);
+	size_t read;
+	while ((read = std::fread(chunk.data(), 1, chunk.size(), stdin)) > 0) {
+		filter.Feed(chunk.data(), read, sink);
+	}
+	filter.Finish(sink);
+
+	if (mode == CLIKit::AnsiFilterMode::Html) std::fputs("</pre>\n", stdout);
+	return 0;
+}
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <iostream>
 #include <string>
 #include <chrono>
@@ -10,6 +12,13 @@
 #include <functional>
 #include <random>
 #include <ctime>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <string_view>
+#include <initializer_list>
 
 #ifdef _WIN32
 #ifndef NOMINMAX
@@ -21,6 +30,7 @@
 #include <termios.h>
 #include <unistd.h>            // For STDIN_FILENO
 #include <sys/ioctl.h>
+#include <sys/select.h>
 #endif
 
 
@@ -81,6 +91,21 @@ namespace CLIKit {
         std::this_thread::sleep_for(std::chrono::milliseconds(Milliseconds));
     }
 
+    // Selected with SetOutputMode (CLIKitJson.h).
+    enum class OutputMode
+    {
+        Text,      // colored, human readable output (default)
+        JsonLines, // one JSON object per line for the Print* family, no colors
+    };
+
+    namespace detail {
+        inline std::atomic<OutputMode> outputMode{ OutputMode::Text };
+    }
+
+    inline OutputMode GetOutputMode() {
+        return detail::outputMode.load(std::memory_order_relaxed);
+    }
+
     inline std::tm LocalTimeNow() {
         using namespace std::chrono;
         std::time_t now_c = system_clock::to_time_t(system_clock::now());
@@ -110,7 +135,11 @@ namespace CLIKit {
         const std::string& colorAMPM = ""
     )
     {
-        const std::string& colorReset = Color::RESET;
+        // Structured output must not contain escape codes
+        const bool plain = GetOutputMode() == OutputMode::JsonLines;
+        const std::string noColor;
+        auto color = [&](const std::string& c) -> const std::string& { return plain ? noColor : c; };
+        const std::string colorReset = plain ? "" : Color::RESET;
 
         std::tm local_tm = LocalTimeNow();
 
@@ -143,13 +172,13 @@ namespace CLIKit {
         // Year
         if (addYear) {
             if (!first) oss << " "; // or add a dash, etc.
-            oss << colorYear << year << colorReset;
+            oss << color(colorYear) << year << colorReset;
             first = false;
         }
         // Month
         if (addMonth) {
             if (!first) oss << "-";
-            oss << colorMonth;
+            oss << color(colorMonth);
             if (month < 10) oss << "0";
             oss << month << colorReset;
             first = false;
@@ -157,7 +186,7 @@ namespace CLIKit {
         // Day
         if (addDay) {
             if (!first) oss << "-";
-            oss << colorDay;
+            oss << color(colorDay);
             if (day < 10) oss << "0";
             oss << day << colorReset;
             first = false;
@@ -166,7 +195,7 @@ namespace CLIKit {
         // Hour
         if (addHour) {
             if (!first) oss << " ";
-            oss << colorHour;
+            oss << color(colorHour);
             if (hour < 10) oss << "0";
             oss << hour << colorReset;
             first = false;
@@ -174,20 +203,20 @@ namespace CLIKit {
         // Minute
         if (addMinute) {
             oss << ":";
-            oss << colorMinute;
+            oss << color(colorMinute);
             if (minute < 10) oss << "0";
             oss << minute << colorReset;
         }
         // Second
         if (addSecond) {
             oss << ":";
-            oss << colorSecond;
+            oss << color(colorSecond);
             if (second < 10) oss << "0";
             oss << second << colorReset;
         }
         // AM/PM if in 12hr mode
         if (!is24HourFormat && (addHour || addMinute || addSecond)) {
-            oss << colorAMPM;
+            oss << color(colorAMPM);
             oss << (isPM ? " PM" : " AM");
             oss << colorReset;
         }
@@ -222,7 +251,7 @@ namespace CLIKit {
         }
     }
 
-    static void WaitForInput(const std::string& Message) {
+    inline void WaitForInput(const std::string& Message) {
         std::cout << Message;
 
 #ifdef _WIN32
@@ -314,96 +343,124 @@ namespace CLIKit {
         }
     }
 
-    inline KeyResult PollKey()
-    {
+    namespace detail {
+        // Called with every key PollKey returns while set; SessionRecorder
+        // (CLIKitRecorder.h) records input through it.
+        inline std::atomic<void (*)(const KeyResult&)> keyObserver{ nullptr };
+
+#ifndef _WIN32
+        // getchar() that retries when a signal (e.g. SIGWINCH) interrupts
+        // the read, instead of reporting EOF.
+        inline int ReadChar()
+        {
+            while (true) {
+                int ch = getchar();
+                if (ch != EOF || !std::ferror(stdin) || errno != EINTR) return ch;
+                std::clearerr(stdin);
+            }
+        }
+#endif
+
+        inline KeyResult ReadKey()
+        {
 #ifdef _WIN32
 
-        int ch1 = _getch();  // read one char
-        // Check for arrow keys or special keys:
-        if (ch1 == 224 || ch1 == 0) {
-            // This indicates a special key was pressed. Need another read:
-            int ch2 = _getch();
-            switch (ch2) {
-            case 72: return { Key::UpArrow,    0 }; // up
-            case 80: return { Key::DownArrow,  0 }; // down
-            case 75: return { Key::LeftArrow,  0 }; // left
-            case 77: return { Key::RightArrow, 0 }; // right
-            default: return { Key::Unknown,    0 };
+            int ch1 = _getch();  // read one char
+            // Check for arrow keys or special keys:
+            if (ch1 == 224 || ch1 == 0) {
+                // This indicates a special key was pressed. Need another read:
+                int ch2 = _getch();
+                switch (ch2) {
+                case 72: return { Key::UpArrow,    0 }; // up
+                case 80: return { Key::DownArrow,  0 }; // down
+                case 75: return { Key::LeftArrow,  0 }; // left
+                case 77: return { Key::RightArrow, 0 }; // right
+                default: return { Key::Unknown,    0 };
+                }
+            }
+            else {
+                // Normal keys:
+                if (ch1 == 13)  return { Key::Enter,     0 };
+                if (ch1 == 27)  return { Key::Escape,    0 };
+                if (ch1 == 8)   return { Key::Backspace, 0 };
+                if (ch1 == 32)  return { Key::Space,     0 };
+                // Otherwise treat as Key::Char
+                return { Key::Char, static_cast<char>(ch1) };
             }
-        }
-        else {
-            // Normal keys:
-            if (ch1 == 13)  return { Key::Enter,     0 };
-            if (ch1 == 27)  return { Key::Escape,    0 };
-            if (ch1 == 8)   return { Key::Backspace, 0 };
-            if (ch1 == 32)  return { Key::Space,     0 };
-            // Otherwise treat as Key::Char
-            return { Key::Char, static_cast<char>(ch1) };
-        }
 
 #else // Linux / macOS / etc.
 
-        // Put terminal in raw mode so we can read key-by-key:
-        termios oldt;
-        tcgetattr(STDIN_FILENO, &oldt);
-        termios newt = oldt;
-        newt.c_lflag &= ~(ICANON | ECHO);  // no canonical, no echo
-        tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-
-        // Read chars
-        int ch1 = getchar();
-
-        // If ch1 == 27, could be ESC or an arrow key (escape sequence)
-        if (ch1 == 27) {
-            // Peek next chars without blocking if they aren't available?
-            // For simplicity, do a blocking read. If we get '[' -> arrow key sequence
-            int ch2 = getchar();
-            if (ch2 == '[') {
-                int ch3 = getchar(); // final char of escape sequence
-                switch (ch3) {
-                case 'A': // up
-                    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-                    return { Key::UpArrow, 0 };
-                case 'B': // down
-                    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-                    return { Key::DownArrow, 0 };
-                case 'D': // left
+            // Put terminal in raw mode so we can read key-by-key:
+            termios oldt;
+            tcgetattr(STDIN_FILENO, &oldt);
+            termios newt = oldt;
+            newt.c_lflag &= ~(ICANON | ECHO);  // no canonical, no echo
+            tcsetattr(STDIN_FILENO, TCSANOW, &newt);
+
+            // Read chars
+            int ch1 = ReadChar();
+
+            // If ch1 == 27, could be ESC or an arrow key (escape sequence)
+            if (ch1 == 27) {
+                // Peek next chars without blocking if they aren't available?
+                // For simplicity, do a blocking read. If we get '[' -> arrow key sequence
+                int ch2 = ReadChar();
+                if (ch2 == '[') {
+                    int ch3 = ReadChar(); // final char of escape sequence
+                    switch (ch3) {
+                    case 'A': // up
+                        tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+                        return { Key::UpArrow, 0 };
+                    case 'B': // down
+                        tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+                        return { Key::DownArrow, 0 };
+                    case 'D': // left
+                        tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+                        return { Key::LeftArrow, 0 };
+                    case 'C': // right
+                        tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+                        return { Key::RightArrow, 0 };
+                    default:
+                        // Some other escape sequence
+                        tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+                        return { Key::Unknown, 0 };
+                    }
+                }
+                // If ch2 != '[', it's just ESC pressed
+                tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+                return { Key::Escape, 0 };
+            }
+            else {
+                // Normal key:
+                if (ch1 == '\n' || ch1 == '\r') {
                     tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-                    return { Key::LeftArrow, 0 };
-                case 'C': // right
+                    return { Key::Enter, 0 };
+                }
+                else if (ch1 == 127 || ch1 == 8) {
+                    // backspace
                     tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-                    return { Key::RightArrow, 0 };
-                default:
-                    // Some other escape sequence
+                    return { Key::Backspace, 0 };
+                }
+                else if (ch1 == ' ') {
                     tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-                    return { Key::Unknown, 0 };
+                    return { Key::Space, 0 };
                 }
-            }
-            // If ch2 != '[', it's just ESC pressed
-            tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-            return { Key::Escape, 0 };
-        }
-        else {
-            // Normal key:
-            if (ch1 == '\n' || ch1 == '\r') {
-                tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-                return { Key::Enter, 0 };
-            }
-            else if (ch1 == 127 || ch1 == 8) {
-                // backspace
+                // Otherwise treat as normal char
                 tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-                return { Key::Backspace, 0 };
+                return { Key::Char, static_cast<char>(ch1) };
             }
-            else if (ch1 == ' ') {
-                tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-                return { Key::Space, 0 };
-            }
-            // Otherwise treat as normal char
-            tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-            return { Key::Char, static_cast<char>(ch1) };
-        }
 
 #endif
+        }
+    }
+
+    inline KeyResult PollKey()
+    {
+        KeyResult kr = detail::ReadKey();
+        if (auto observer = detail::keyObserver.load(std::memory_order_acquire)) {
+            observer(kr);
+        }
+        return kr;
     }
 
     inline bool KeyboardEvent(const std::string& desiredKey)
@@ -428,7 +485,7 @@ namespace CLIKit {
         return false;
     }
 
-    static void SetConsoleTitle(const std::string& title) {
+    inline void SetConsoleTitle(const std::string& title) {
 #ifdef _WIN32
         SetConsoleTitleA(title.c_str());
 #else
@@ -446,13 +503,269 @@ namespace CLIKit {
         return 80; // fallback
 #else
         struct winsize w;
-        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == 0) {
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == 0 && w.ws_col > 0) {
             return w.ws_col;
         }
         return 80; // fallback
 #endif
     }
 
+    inline int GetTerminalHeight()
+    {
+#ifdef _WIN32
+        CONSOLE_SCREEN_BUFFER_INFO csbi;
+        if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)) {
+            return csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+        }
+        return 24; // fallback
+#else
+        struct winsize w;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == 0 && w.ws_row > 0) {
+            return w.ws_row;
+        }
+        return 24; // fallback
+#endif
+    }
+
+    // Lets the Windows console interpret escape sequences; no-op elsewhere.
+    inline void EnableVirtualTerminal()
+    {
+#ifdef _WIN32
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+        static const bool enabled = [] {
+            HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+            DWORD mode = 0;
+            if (!GetConsoleMode(handle, &mode)) return false;
+            return SetConsoleMode(handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+        }();
+        (void)enabled;
+#endif
+    }
+
+    namespace detail {
+        // Whether Frame wraps its output in synchronized-update markers.
+        // Starts from CLIKIT_SYNC_OUTPUT; DetectSynchronizedOutput() updates it.
+        inline std::atomic<bool>& SynchronizedOutputEnabled()
+        {
+            static std::atomic<bool> enabled{ [] {
+                const char* env = std::getenv("CLIKIT_SYNC_OUTPUT");
+                return env && env[0] == '1';
+            }() };
+            return enabled;
+        }
+
+        // Asks the terminal whether it knows DEC mode 2026 (synchronized output).
+        // A DA1 query is sent right after so terminals that ignore the first
+        // question still answer something and we don't wait for the timeout.
+        inline bool QuerySynchronizedOutput()
+        {
+#ifdef _WIN32
+            return false;
+#else
+            if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) {
+                return false;
+            }
+
+            termios oldt;
+            if (tcgetattr(STDIN_FILENO, &oldt) != 0) {
+                return false;
+            }
+            termios newt = oldt;
+            newt.c_lflag &= ~(ICANON | ECHO);
+            newt.c_cc[VMIN] = 0;
+            newt.c_cc[VTIME] = 0;
+            tcsetattr(STDIN_FILENO, TCSANOW, &newt);
+
+            std::cout << "\033[?2026$p\033[c" << std::flush;
+
+            std::string reply;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+            while (true) {
+                auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count();
+                if (remaining <= 0) break;
+
+                fd_set fds;
+                FD_ZERO(&fds);
+                FD_SET(STDIN_FILENO, &fds);
+                timeval tv;
+                tv.tv_sec = static_cast<long>(remaining / 1000000);
+                tv.tv_usec = static_cast<long>(remaining % 1000000);
+                if (select(STDIN_FILENO + 1, &fds, nullptr, nullptr, &tv) <= 0) break;
+
+                char buf[64];
+                ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+                if (n <= 0) break;
+                reply.append(buf, static_cast<size_t>(n));
+
+                // The DA1 answer (ESC [ ? ... c) always comes last
+                size_t da = reply.rfind("\033[?");
+                if (da != std::string::npos && reply.find('c', da) != std::string::npos) break;
+            }
+
+            // Drop whatever else arrived (a partial reply after a timeout)
+            // so it doesn't show up as keys in the next PollKey/GetInput
+            tcflush(STDIN_FILENO, TCIFLUSH);
+            tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+
+            // DECRPM answer: ESC [ ? 2026 ; Ps $ y, Ps 1/2 = set/reset (known)
+            size_t pos = reply.find("\033[?2026;");
+            if (pos == std::string::npos || pos + 8 >= reply.size()) return false;
+            return reply[pos + 8] == '1' || reply[pos + 8] == '2';
+#endif
+        }
+    }
+
+    // Off unless CLIKIT_SYNC_OUTPUT=1 is set or DetectSynchronizedOutput()
+    // found support. Never queries the terminal itself.
+    inline bool SupportsSynchronizedOutput()
+    {
+        return detail::SynchronizedOutputEnabled().load(std::memory_order_relaxed);
+    }
+
+    // Asks the terminal (once per process) whether it supports synchronized
+    // output and turns it on for Frame if so. This reads stdin in raw mode
+    // for up to 200 ms and discards keys typed meanwhile, so call it before
+    // the program starts reading input; AlternateScreen does.
+    // CLIKIT_SYNC_OUTPUT=0/1 skips the query.
+    inline bool DetectSynchronizedOutput()
+    {
+        static const bool supported = [] {
+            if (const char* env = std::getenv("CLIKIT_SYNC_OUTPUT")) {
+                return env[0] == '1';
+            }
+            return detail::QuerySynchronizedOutput();
+        }();
+        detail::SynchronizedOutputEnabled().store(supported, std::memory_order_relaxed);
+        return supported;
+    }
+
+    inline void ClearScreen()
+    {
+        EnableVirtualTerminal();
+        std::cout << "\033[2J\033[H" << std::flush;
+    }
+
+    // Clears rows `top` to `bottom` (1-based, inclusive) and leaves the
+    // cursor at the start of `top`.
+    inline void ClearLines(int top, int bottom)
+    {
+        std::string out;
+        for (int row = top; row <= bottom; row++) {
+            out += "\033[" + std::to_string(row) + ";1H\033[2K";
+        }
+        out += "\033[" + std::to_string(top) + ";1H";
+        std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+        std::cout.flush();
+    }
+
+    // Switches to the alternate screen and hides the cursor for as long as
+    // the object lives, so a full-screen UI leaves the shell's scrollback
+    // untouched when it exits. Also detects synchronized output, since a
+    // full-screen UI is about to start drawing frames.
+    class AlternateScreen
+    {
+    public:
+        AlternateScreen() {
+            EnableVirtualTerminal();
+            DetectSynchronizedOutput();
+            std::cout << "\033[?1049h\033[H\033[?25l" << std::flush;
+        }
+
+        ~AlternateScreen() {
+            std::cout << "\033[?25h\033[?1049l" << std::flush;
+        }
+
+        AlternateScreen(const AlternateScreen&) = delete;
+        AlternateScreen& operator=(const AlternateScreen&) = delete;
+    };
+
+    // Collects one frame of output and writes it with a single call, wrapped
+    // in synchronized-update markers when the terminal supports them, so the
+    // terminal never shows a half-drawn frame. Commits on destruction.
+    class Frame
+    {
+    public:
+        Frame() {
+            buffer.reserve(256);
+        }
+
+        ~Frame() {
+            Commit();
+        }
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+        Frame& operator<<(std::string_view text) {
+            buffer.append(text.data(), text.size());
+            return *this;
+        }
+
+        Frame& operator<<(const char* text) {
+            buffer.append(text);
+            return *this;
+        }
+
+        Frame& operator<<(const std::string& text) {
+            buffer.append(text);
+            return *this;
+        }
+
+        Frame& operator<<(char c) {
+            buffer.push_back(c);
+            return *this;
+        }
+
+        template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+        Frame& operator<<(T value) {
+            if constexpr (std::is_integral_v<T>) {
+                buffer.append(std::to_string(value));
+            }
+            else {
+                char buf[32];
+                int len = std::snprintf(buf, sizeof(buf), "%g", static_cast<double>(value));
+                if (len > 0) buffer.append(buf, static_cast<size_t>(len));
+            }
+            return *this;
+        }
+
+        // Moves the cursor (1-based row and column).
+        Frame& MoveTo(int row, int column) {
+            buffer += "\033[" + std::to_string(row) + ";" + std::to_string(column) + "H";
+            return *this;
+        }
+
+        Frame& ClearLine() {
+            buffer.append("\r\033[2K");
+            return *this;
+        }
+
+        Frame& ClearScreen() {
+            buffer.append("\033[2J\033[H");
+            return *this;
+        }
+
+        std::string& Buffer() {
+            return buffer;
+        }
+
+        // Writes the frame now; the Frame can then be reused for the next one.
+        void Commit() {
+            if (buffer.empty()) return;
+            bool sync = SupportsSynchronizedOutput();
+            if (sync) buffer.insert(0, "\033[?2026h");
+            if (sync) buffer.append("\033[?2026l");
+            std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            std::cout.flush();
+            buffer.clear();
+        }
+
+    private:
+        std::string buffer;
+    };
+
     inline void PrintCentered(const std::string& text)
     {
         int width = GetTerminalWidth();
@@ -505,9 +818,11 @@ namespace CLIKit {
         int spinIndex = 0;
         auto start = std::chrono::steady_clock::now();
 
+        Frame frame;
         while (true) {
-            // Print spinning char and flush.
-            std::cout << "\r" << spinChars[spinIndex++] << std::flush;
+            // Print spinning char as one frame.
+            frame << '\r' << spinChars[spinIndex++];
+            frame.Commit();
             if (spinIndex == 4) {
                 spinIndex = 0;
             }
@@ -523,7 +838,7 @@ namespace CLIKit {
         std::cout << "\r " << std::endl;
     }
 
-    std::string ProgressBar(int CurrentPercentage,
+    inline std::string ProgressBar(int CurrentPercentage,
         int MaxPercentage,
         int BarWidth,
         const std::string& PrefixText,
@@ -610,7 +925,7 @@ namespace CLIKit {
         return result;
     }
 
-    std::string Spacing(int NumberOfSpaces) {
+    inline std::string Spacing(int NumberOfSpaces) {
         std::string spacing;
         for (int i = 0; i < NumberOfSpaces; i++) {
             spacing.append("\n");
@@ -618,24 +933,114 @@ namespace CLIKit {
         return spacing;
     }
 
-    inline void PrintWarning(const std::string& msg) {
+    namespace detail {
+        // One formatting argument, viewed as text without allocating.
+        // `quoted` tells JSON output whether to write it as a string.
+        struct FormatArg
+        {
+            const char* data = nullptr;
+            size_t size = 0;
+            bool quoted = true;
+            char buf[32];
+
+            FormatArg(const std::string& s) : data(s.data()), size(s.size()) {}
+            FormatArg(std::string_view s) : data(s.data()), size(s.size()) {}
+            FormatArg(const char* s) : data(s), size(std::strlen(s)) {}
+            FormatArg(char c) : data(buf), size(1) { buf[0] = c; }
+            FormatArg(bool b) : data(b ? "true" : "false"), size(b ? 4 : 5), quoted(false) {}
+
+            template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+            FormatArg(T value) : data(buf), quoted(false) {
+                int len;
+                if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                    len = std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(value));
+                }
+                else if constexpr (std::is_integral_v<T>) {
+                    len = std::snprintf(buf, sizeof(buf), "%llu", static_cast<unsigned long long>(value));
+                }
+                else {
+                    double d = static_cast<double>(value);
+                    len = std::snprintf(buf, sizeof(buf), "%g", d);
+                    quoted = !(d - d == 0.0); // nan/inf aren't JSON numbers
+                }
+                size = len > 0 ? static_cast<size_t>(len) : 0;
+            }
+
+            // `data` may point into `buf`, so copies would dangle
+            FormatArg(const FormatArg&) = delete;
+            FormatArg& operator=(const FormatArg&) = delete;
+        };
+    }
+
+    // Key/value pair attached to a Print* call, e.g.
+    // PrintError("disk full", { { "device", "sda1" }, { "used", 97.5 } });
+    struct LogField
+    {
+        std::string_view key;
+        detail::FormatArg value;
+    };
+
+    namespace detail {
+        // When set, gets every finished text-mode Print* line and returns
+        // true if it took it; PaneLayout (CLIKitPanes.h) routes logs this way.
+        inline std::atomic<bool (*)(const std::string&)> logRouter{ nullptr };
+
+        // Set while OutputMode::JsonLines is selected (CLIKitJson.h); writes
+        // Print* calls as JSON records instead.
+        using LogRecordWriter = void (*)(const char* level,
+            const std::string& msg,
+            std::initializer_list<LogField> fields,
+            bool flushNow);
+        inline std::atomic<LogRecordWriter> logRecordWriter{ nullptr };
+
+        inline void PrintLevel(const char* color,
+            const char* tag,
+            const char* level,
+            const std::string& msg,
+            std::initializer_list<LogField> fields,
+            bool flushNow = false)
+        {
+            if (auto writer = logRecordWriter.load(std::memory_order_acquire)) {
+                writer(level, msg, fields, flushNow);
+                return;
+            }
+
+            std::string line = color;
+            line += tag;
+            line += msg;
+            for (const auto& field : fields) {
+                line += ' ';
+                line += field.key;
+                line += '=';
+                line.append(field.value.data, field.value.size);
+            }
+            line += Color::RESET;
+
+            auto router = logRouter.load(std::memory_order_acquire);
+            if (!router || !router(line)) {
+                std::cout << line << std::endl;
+            }
+        }
+    }
+
+    inline void PrintWarning(const std::string& msg, std::initializer_list<LogField> fields = {}) {
         // Often yellow for warnings
-        std::cout << Color::LIGHT_YELLOW << "[WARNING] " << msg << Color::RESET << std::endl;
+        detail::PrintLevel(Color::LIGHT_YELLOW, "[WARNING] ", "warning", msg, fields);
     }
 
-    inline void PrintError(const std::string& msg) {
+    inline void PrintError(const std::string& msg, std::initializer_list<LogField> fields = {}) {
         // Often red for errors
-        std::cout << Color::LIGHT_RED << "[ERROR] " << msg << Color::RESET << std::endl;
+        detail::PrintLevel(Color::LIGHT_RED, "[ERROR] ", "error", msg, fields, true);
     }
 
-    inline void PrintSuccess(const std::string& msg) {
+    inline void PrintSuccess(const std::string& msg, std::initializer_list<LogField> fields = {}) {
         // Often green for success
-        std::cout << Color::LIGHT_GREEN << "[SUCCESS] " << msg << Color::RESET << std::endl;
+        detail::PrintLevel(Color::LIGHT_GREEN, "[SUCCESS] ", "success", msg, fields);
     }
 
-    inline void PrintInfo(const std::string& msg) {
+    inline void PrintInfo(const std::string& msg, std::initializer_list<LogField> fields = {}) {
         // Often cyan for info
-        std::cout << Color::LIGHT_CYAN << "[INFO] " << msg << Color::RESET << std::endl;
+        detail::PrintLevel(Color::LIGHT_CYAN, "[INFO] ", "info", msg, fields);
     }
 
     inline void RenderASCIIArt(const std::string& ascii, bool center = false)
@@ -727,12 +1132,8 @@ namespace CLIKit {
         // Set console title
         SetConsoleTitle("CLIKit Demo");
 
-        // Clear the screen (optional, platform-dependent)
-#ifdef _WIN32
-        system("cls");
-#else
-        system("clear");
-#endif
+        // Clear the screen
+        ClearScreen();
 
         // Render ASCII Art
         std::string asciiArt = R"(
@@ -798,8 +1199,9 @@ namespace CLIKit {
         // Demonstrate Progress Bar
         PrintInfo("Progress Bar Demonstration:");
         const int total = 100;
+        Frame frame;
         for (int i = 0; i <= total; ++i) {
-            std::cout << "\r" << ProgressBar(
+            frame << "\r" << ProgressBar(
                 i,
                 total,
                 50,
@@ -816,7 +1218,8 @@ namespace CLIKit {
                 true,
                 true,
                 true
-            ) << std::flush;
+            );
+            frame.Commit();
             std::this_thread::sleep_for(std::chrono::milliseconds(50));
         }
         std::cout << "\n\n";
@@ -0,0 +1,310 @@
+#pragma once
+// Streaming ANSI escape filter: strip escape codes or turn colors into HTML.
+#include "CLIKit.h"
+
+#include <cstring>
+#include <streambuf>
+#include <string>
+
+namespace CLIKit {
+
+    enum class AnsiFilterMode
+    {
+        Strip,       // drop all escape sequences, keep plain text
+        Html,        // turn SGR colors/styles into <span> tags, drop everything else
+        Passthrough, // forward the input unchanged
+    };
+
+    // Streaming filter for ANSI escape sequences. Input can be fed in chunks
+    // of any size; a sequence split across two chunks is carried over.
+    // Plain text between escapes is located with memchr (vectorized in every
+    // mainstream libc) and handed to the sink as spans of the input itself,
+    // so nothing is copied unless the sink copies it.
+    class AnsiFilter
+    {
+    public:
+        explicit AnsiFilter(AnsiFilterMode mode = AnsiFilterMode::Strip)
+            : mode(mode) {}
+
+        // Sink is any callable taking (const char* data, size_t size).
+        template<typename Sink>
+        void Feed(const char* data, size_t size, Sink&& sink)
+        {
+            const char* p = data;
+            const char* end = data + size;
+
+            if (mode == AnsiFilterMode::Passthrough) {
+                if (size > 0) sink(data, size);
+                return;
+            }
+
+            while (p < end) {
+                if (state == State::Text) {
+                    const char* esc = static_cast<const char*>(std::memchr(p, 0x1B, static_cast<size_t>(end - p)));
+                    const char* runEnd = esc ? esc : end;
+                    if (mode == AnsiFilterMode::Html) {
+                        EmitHtmlText(p, runEnd, sink);
+                    }
+                    else if (runEnd > p) {
+                        sink(p, static_cast<size_t>(runEnd - p));
+                    }
+                    if (!esc) return;
+                    p = esc + 1;
+                    state = State::Escape;
+                    continue;
+                }
+
+                char c = *p++;
+                switch (state) {
+                case State::Escape:
+                    if (c == '[') {
+                        state = State::Csi;
+                        params.clear();
+                    }
+                    else if (c == ']' || c == 'P' || c == 'X' || c == '^' || c == '_') {
+                        state = State::String; // OSC/DCS/etc, ended by BEL or ESC '\'
+                    }
+                    else if (c >= 0x20 && c <= 0x2F) {
+                        state = State::Intermediate; // e.g. ESC ( B, charset selection
+                    }
+                    else if (c != 0x1B) {
+                        state = State::Text;   // two-byte sequence, dropped
+                    }
+                    break;
+                case State::Intermediate:
+                    // More intermediates, then one final byte ends the sequence
+                    if (c == 0x1B) state = State::Escape;
+                    else if (c < 0x20 || c > 0x2F) state = State::Text;
+                    break;
+                case State::Csi:
+                    if (c == 0x1B) {
+                        state = State::Escape; // aborted, a new sequence starts
+                    }
+                    else if (c >= 0x40 && c <= 0x7E) {
+                        // Final byte; only SGR ('m') means anything to us
+                        if (c == 'm' && mode == AnsiFilterMode::Html) {
+                            ApplySgr(sink);
+                        }
+                        state = State::Text;
+                    }
+                    else if (params.size() < 64) {
+                        params.push_back(c);
+                    }
+                    break;
+                case State::String:
+                    if (c == '\a') state = State::Text;
+                    else if (c == 0x1B) state = State::StringEscape;
+                    break;
+                case State::StringEscape:
+                    state = (c == '\\') ? State::Text : State::String;
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+        void Feed(const char* data, size_t size, std::string& out) {
+            Feed(data, size, [&out](const char* s, size_t n) { out.append(s, n); });
+        }
+
+        // Ends the stream: closes an open HTML span and drops any
+        // unterminated escape sequence.
+        template<typename Sink>
+        void Finish(Sink&& sink)
+        {
+            if (spanOpen) {
+                sink("</span>", 7);
+                spanOpen = false;
+            }
+            style = Style{};
+            state = State::Text;
+            params.clear();
+        }
+
+        void Finish(std::string& out) {
+            Finish([&out](const char* s, size_t n) { out.append(s, n); });
+        }
+
+        // Converts a 256-color palette index to 0xRRGGBB.
+        static int PaletteToRgb(int index)
+        {
+            static constexpr int basic[16] = {
+                0x000000, 0xcd0000, 0x00cd00, 0xcdcd00, 0x0000ee, 0xcd00cd, 0x00cdcd, 0xe5e5e5,
+                0x7f7f7f, 0xff0000, 0x00ff00, 0xffff00, 0x5c5cff, 0xff00ff, 0x00ffff, 0xffffff,
+            };
+            if (index < 0 || index > 255) return -1;
+            if (index < 16) return basic[index];
+            if (index >= 232) {
+                int gray = 8 + (index - 232) * 10;
+                return (gray << 16) | (gray << 8) | gray;
+            }
+            static constexpr int levels[6] = { 0, 95, 135, 175, 215, 255 };
+            index -= 16;
+            return (levels[index / 36] << 16) | (levels[(index / 6) % 6] << 8) | levels[index % 6];
+        }
+
+    private:
+        enum class State { Text, Escape, Intermediate, Csi, String, StringEscape };
+
+        struct Style
+        {
+            int fg = -1; // 0xRRGGBB, -1 = default
+            int bg = -1;
+            bool bold = false;
+            bool italic = false;
+            bool underline = false;
+
+            bool IsDefault() const {
+                return fg < 0 && bg < 0 && !bold && !italic && !underline;
+            }
+        };
+
+        template<typename Sink>
+        static void EmitHtmlText(const char* p, const char* end, Sink& sink)
+        {
+            const char* run = p;
+            for (; p < end; p++) {
+                const char* entity = nullptr;
+                switch (*p) {
+                case '<': entity = "&lt;"; break;
+                case '>': entity = "&gt;"; break;
+                case '&': entity = "&amp;"; break;
+                default: continue;
+                }
+                if (p > run) sink(run, static_cast<size_t>(p - run));
+                sink(entity, std::strlen(entity));
+                run = p + 1;
+            }
+            if (end > run) sink(run, static_cast<size_t>(end - run));
+        }
+
+        template<typename Sink>
+        void ApplySgr(Sink& sink)
+        {
+            // Split "1;38;5;208" into numbers; an empty list means reset
+            int codes[32];
+            int count = 0;
+            int value = 0;
+            bool hasDigits = false;
+            for (size_t i = 0; i <= params.size(); i++) {
+                char c = i < params.size() ? params[i] : ';';
+                if (c >= '0' && c <= '9') {
+                    value = value * 10 + (c - '0');
+                    hasDigits = true;
+                }
+                else if (c == ';' || c == ':') {
+                    if (count < 32) codes[count++] = hasDigits ? value : 0;
+                    value = 0;
+                    hasDigits = false;
+                }
+            }
+
+            for (int i = 0; i < count; i++) {
+                int code = codes[i];
+                if (code == 0) style = Style{};
+                else if (code == 1) style.bold = true;
+                else if (code == 3) style.italic = true;
+                else if (code == 4) style.underline = true;
+                else if (code == 22) style.bold = false;
+                else if (code == 23) style.italic = false;
+                else if (code == 24) style.underline = false;
+                else if (code >= 30 && code <= 37) style.fg = PaletteToRgb(code - 30);
+                else if (code >= 90 && code <= 97) style.fg = PaletteToRgb(code - 90 + 8);
+                else if (code >= 40 && code <= 47) style.bg = PaletteToRgb(code - 40);
+                else if (code >= 100 && code <= 107) style.bg = PaletteToRgb(code - 100 + 8);
+                else if (code == 39) style.fg = -1;
+                else if (code == 49) style.bg = -1;
+                else if (code == 38 || code == 48) {
+                    int color = -1;
+                    if (i + 2 < count && codes[i + 1] == 5) {
+                        color = PaletteToRgb(codes[i + 2]);
+                        i += 2;
+                    }
+                    else if (i + 4 < count && codes[i + 1] == 2) {
+                        color = ((codes[i + 2] & 0xFF) << 16) | ((codes[i + 3] & 0xFF) << 8) | (codes[i + 4] & 0xFF);
+                        i += 4;
+                    }
+                    (code == 38 ? style.fg : style.bg) = color;
+                }
+            }
+
+            if (spanOpen) {
+                sink("</span>", 7);
+                spanOpen = false;
+            }
+            if (style.IsDefault()) return;
+
+            char buf[128];
+            int len = std::snprintf(buf, sizeof(buf), "<span style=\"");
+            if (style.fg >= 0) len += std::snprintf(buf + len, sizeof(buf) - len, "color:#%06x;", style.fg);
+            if (style.bg >= 0) len += std::snprintf(buf + len, sizeof(buf) - len, "background-color:#%06x;", style.bg);
+            if (style.bold) len += std::snprintf(buf + len, sizeof(buf) - len, "font-weight:bold;");
+            if (style.italic) len += std::snprintf(buf + len, sizeof(buf) - len, "font-style:italic;");
+            if (style.underline) len += std::snprintf(buf + len, sizeof(buf) - len, "text-decoration:underline;");
+            len += std::snprintf(buf + len, sizeof(buf) - len, "\">");
+            sink(buf, static_cast<size_t>(len));
+            spanOpen = true;
+        }
+
+        AnsiFilterMode mode;
+        State state = State::Text;
+        std::string params; // CSI parameter bytes of the sequence being read
+        Style style;
+        bool spanOpen = false;
+    };
+
+    // Stream buffer that filters everything written to it into `target`,
+    // e.g. `std::cout.rdbuf(&filter)` to strip colors when piping, or wrap
+    // it in an std::ostream to log a plain copy to a file. If `rawTarget`
+    // is given, the unfiltered bytes are teed to it as well.
+    class AnsiFilterBuffer : public std::streambuf
+    {
+    public:
+        AnsiFilterBuffer(std::streambuf* target,
+            AnsiFilterMode mode = AnsiFilterMode::Strip,
+            std::streambuf* rawTarget = nullptr)
+            : target(target), rawTarget(rawTarget), filter(mode), buffer(8192)
+        {
+            setp(buffer.data(), buffer.data() + buffer.size());
+        }
+
+        ~AnsiFilterBuffer() override {
+            FlushBuffer();
+            filter.Finish([this](const char* s, size_t n) { target->sputn(s, static_cast<std::streamsize>(n)); });
+            target->pubsync();
+        }
+
+    protected:
+        int_type overflow(int_type ch) override {
+            FlushBuffer();
+            if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override {
+            FlushBuffer();
+            if (rawTarget) rawTarget->pubsync();
+            return target->pubsync();
+        }
+
+    private:
+        void FlushBuffer() {
+            size_t size = static_cast<size_t>(pptr() - pbase());
+            if (size == 0) return;
+            if (rawTarget) rawTarget->sputn(pbase(), static_cast<std::streamsize>(size));
+            filter.Feed(pbase(), size, [this](const char* s, size_t n) {
+                target->sputn(s, static_cast<std::streamsize>(n));
+            });
+            setp(buffer.data(), buffer.data() + buffer.size());
+        }
+
+        std::streambuf* target;
+        std::streambuf* rawTarget;
+        AnsiFilter filter;
+        std::vector<char> buffer;
+    };
+}
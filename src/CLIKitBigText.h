@@ -0,0 +1,348 @@
+#pragma once
+// Big text banners from a built-in font or a FIGlet (.flf) file.
+#include "CLIKit.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace CLIKit {
+
+    // Big text font: every glyph is stored as `height` rows of `width` bytes,
+    // back to back in a single atlas string, so a glyph row is one memcpy.
+    struct BigFont
+    {
+        int height = 0;
+        std::string atlas;
+        std::array<int, 128> offset{}; // -1 if the glyph is missing
+        std::array<int, 128> width{};
+
+        bool HasGlyph(char c) const {
+            unsigned char uc = static_cast<unsigned char>(c);
+            return uc < 128 && offset[uc] >= 0;
+        }
+    };
+
+    namespace detail {
+        struct BigGlyph
+        {
+            char ch;
+            const char* rows[5];
+        };
+
+        // Built-in 5-row block font, embedded at compile time.
+        inline constexpr BigGlyph kBuiltinGlyphs[] = {
+            { ' ', { "   ", "   ", "   ", "   ", "   " } },
+            { 'A', { " ### ", "#   #", "#####", "#   #", "#   #" } },
+            { 'B', { "#### ", "#   #", "#### ", "#   #", "#### " } },
+            { 'C', { " ####", "#    ", "#    ", "#    ", " ####" } },
+            { 'D', { "#### ", "#   #", "#   #", "#   #", "#### " } },
+            { 'E', { "#####", "#    ", "#### ", "#    ", "#####" } },
+            { 'F', { "#####", "#    ", "#### ", "#    ", "#    " } },
+            { 'G', { " ####", "#    ", "#  ##", "#   #", " ####" } },
+            { 'H', { "#   #", "#   #", "#####", "#   #", "#   #" } },
+            { 'I', { "###", " # ", " # ", " # ", "###" } },
+            { 'J', { "  ###", "    #", "    #", "#   #", " ### " } },
+            { 'K', { "#   #", "#  # ", "###  ", "#  # ", "#   #" } },
+            { 'L', { "#    ", "#    ", "#    ", "#    ", "#####" } },
+            { 'M', { "#   #", "## ##", "# # #", "#   #", "#   #" } },
+            { 'N', { "#   #", "##  #", "# # #", "#  ##", "#   #" } },
+            { 'O', { " ### ", "#   #", "#   #", "#   #", " ### " } },
+            { 'P', { "#### ", "#   #", "#### ", "#    ", "#    " } },
+            { 'Q', { " ### ", "#   #", "# # #", "#  # ", " ## #" } },
+            { 'R', { "#### ", "#   #", "#### ", "#  # ", "#   #" } },
+            { 'S', { " ####", "#    ", " ### ", "    #", "#### " } },
+            { 'T', { "#####", "  #  ", "  #  ", "  #  ", "  #  " } },
+            { 'U', { "#   #", "#   #", "#   #", "#   #", " ### " } },
+            { 'V', { "#   #", "#   #", "#   #", " # # ", "  #  " } },
+            { 'W', { "#   #", "#   #", "# # #", "## ##", "#   #" } },
+            { 'X', { "#   #", " # # ", "  #  ", " # # ", "#   #" } },
+            { 'Y', { "#   #", " # # ", "  #  ", "  #  ", "  #  " } },
+            { 'Z', { "#####", "   # ", "  #  ", " #   ", "#####" } },
+            { '0', { " ### ", "#  ##", "# # #", "##  #", " ### " } },
+            { '1', { " # ", "## ", " # ", " # ", "###" } },
+            { '2', { " ### ", "#   #", "  ## ", " #   ", "#####" } },
+            { '3', { "#### ", "    #", " ### ", "    #", "#### " } },
+            { '4', { "#   #", "#   #", "#####", "    #", "    #" } },
+            { '5', { "#####", "#    ", "#### ", "    #", "#### " } },
+            { '6', { " ### ", "#    ", "#### ", "#   #", " ### " } },
+            { '7', { "#####", "    #", "   # ", "  #  ", "  #  " } },
+            { '8', { " ### ", "#   #", " ### ", "#   #", " ### " } },
+            { '9', { " ### ", "#   #", " ####", "    #", " ### " } },
+            { '!', { "#", "#", "#", " ", "#" } },
+            { '?', { " ### ", "#   #", "  ## ", "     ", "  #  " } },
+            { '.', { " ", " ", " ", " ", "#" } },
+            { ',', { "  ", "  ", "  ", " #", "# " } },
+            { ':', { " ", "#", " ", "#", " " } },
+            { '\'', { "#", "#", " ", " ", " " } },
+            { '-', { "   ", "   ", "###", "   ", "   " } },
+            { '+', { "   ", " # ", "###", " # ", "   " } },
+            { '=', { "   ", "###", "   ", "###", "   " } },
+            { '*', { "   ", "# #", " # ", "# #", "   " } },
+            { '_', { "    ", "    ", "    ", "    ", "####" } },
+            { '/', { "    #", "   # ", "  #  ", " #   ", "#    " } },
+            { '%', { "#   #", "   # ", "  #  ", " #   ", "#   #" } },
+            { '(', { " #", "# ", "# ", "# ", " #" } },
+            { ')', { "# ", " #", " #", " #", "# " } },
+        };
+
+        // Appends one glyph (rows already padded to a common width) to the atlas.
+        inline void AddGlyph(BigFont& font, char ch, const std::vector<std::string>& rows) {
+            unsigned char uc = static_cast<unsigned char>(ch);
+            if (uc >= 128) return;
+
+            size_t glyphWidth = 0;
+            for (const auto& row : rows) {
+                glyphWidth = std::max(glyphWidth, row.size());
+            }
+
+            font.offset[uc] = static_cast<int>(font.atlas.size());
+            font.width[uc] = static_cast<int>(glyphWidth);
+            for (const auto& row : rows) {
+                font.atlas.append(row);
+                font.atlas.append(glyphWidth - row.size(), ' ');
+            }
+        }
+    }
+
+    inline const BigFont& DefaultBigFont()
+    {
+        static const BigFont font = [] {
+            BigFont f;
+            f.height = 5;
+            f.offset.fill(-1);
+            for (const auto& glyph : detail::kBuiltinGlyphs) {
+                std::vector<std::string> rows(glyph.rows, glyph.rows + 5);
+                detail::AddGlyph(f, glyph.ch, rows);
+            }
+            return f;
+        }();
+        return font;
+    }
+
+    // Parses a FIGlet (.flf) font file into a glyph atlas. Only the required
+    // printable ASCII range (32-126) is loaded; smushing rules are ignored
+    // (RenderBigText can kern the glyphs instead).
+    inline std::optional<BigFont> LoadFIGletFont(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file) {
+            return std::nullopt;
+        }
+
+        std::string header;
+        if (!std::getline(file, header) || header.size() < 6 || header.compare(0, 5, "flf2a") != 0) {
+            return std::nullopt;
+        }
+        char hardblank = header[5];
+
+        std::istringstream params(header.substr(6));
+        int height = 0, baseline = 0, maxLength = 0, oldLayout = 0, commentLines = 0;
+        if (!(params >> height >> baseline >> maxLength >> oldLayout >> commentLines) || height <= 0) {
+            return std::nullopt;
+        }
+
+        std::string line;
+        for (int i = 0; i < commentLines; i++) {
+            if (!std::getline(file, line)) return std::nullopt;
+        }
+
+        BigFont font;
+        font.height = height;
+        font.offset.fill(-1);
+
+        std::vector<std::string> rows(height);
+        for (int ch = 32; ch <= 126; ch++) {
+            for (int r = 0; r < height; r++) {
+                if (!std::getline(file, line)) {
+                    // Truncated font: keep whatever glyphs were complete
+                    return font.offset[' '] >= 0 ? std::optional<BigFont>(font) : std::nullopt;
+                }
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+
+                // Strip the end mark (last char, doubled on the final row)
+                if (!line.empty()) {
+                    char endMark = line.back();
+                    while (!line.empty() && line.back() == endMark) line.pop_back();
+                }
+                for (char& c : line) {
+                    if (c == hardblank) c = ' ';
+                }
+                rows[r] = line;
+            }
+            detail::AddGlyph(font, static_cast<char>(ch), rows);
+        }
+
+        return font;
+    }
+
+    namespace detail {
+        // Glyph used for `c`: itself, its upper-case form, or '?'; -1 if none.
+        inline int ResolveBigGlyph(const BigFont& font, char c) {
+            if (!font.HasGlyph(c)) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            if (!font.HasGlyph(c)) c = '?';
+            return font.HasGlyph(c) ? static_cast<unsigned char>(c) : -1;
+        }
+
+        // Kerning tracks where the ink ends on every glyph row; taller fonts
+        // are laid out with plain letter spacing.
+        inline constexpr int kMaxKerningRows = 64;
+    }
+
+    // Composes `text` in a big font into `out` (cleared first, capacity kept),
+    // so banners that redraw every frame can reuse the same buffer.
+    // `rowColors` is cycled over the glyph rows to give a vertical gradient.
+    // With `kerning`, each glyph is moved left until its ink is
+    // `letterSpacing` columns from the ink before it on every row (FIGlet
+    // "fitting"); otherwise glyph boxes are `letterSpacing` apart.
+    // `centerWidth` is the width to center in; 0 asks the terminal.
+    inline void RenderBigText(std::string& out,
+        const std::string& text,
+        const BigFont& font = DefaultBigFont(),
+        int letterSpacing = 1,
+        bool center = false,
+        const std::vector<std::string>& rowColors = {},
+        bool kerning = false,
+        int centerWidth = 0)
+    {
+        out.clear();
+        if (letterSpacing < 0) letterSpacing = 0;
+        if (font.height > detail::kMaxKerningRows) kerning = false;
+        if (center && centerWidth <= 0) centerWidth = GetTerminalWidth();
+
+        const int height = font.height;
+        const int resetLength = rowColors.empty() ? 0 : static_cast<int>(std::strlen(Color::RESET));
+        int maxColorLength = 0;
+        for (const auto& color : rowColors) {
+            maxColorLength = std::max(maxColorLength, static_cast<int>(color.size()));
+        }
+
+        size_t lineStart = 0;
+        while (lineStart <= text.size()) {
+            size_t lineEnd = text.find('\n', lineStart);
+            if (lineEnd == std::string::npos) lineEnd = text.size();
+
+            // Widest the line can get (no kerning), to size the rows
+            int maxWidth = 0;
+            bool first = true;
+            for (size_t i = lineStart; i < lineEnd; i++) {
+                int g = detail::ResolveBigGlyph(font, text[i]);
+                if (g < 0) continue;
+                if (!first) maxWidth += letterSpacing;
+                maxWidth += font.width[g];
+                first = false;
+            }
+
+            // Every row gets a fixed slot in `out`; glyphs are copied into it
+            // at their final column, and the slots are packed afterwards.
+            int maxPadding = center ? std::max(0, centerWidth / 2) : 0;
+            int glyphColumn = maxColorLength + maxPadding;
+            size_t stride = static_cast<size_t>(glyphColumn + maxWidth + resetLength + 1);
+            size_t base = out.size();
+            out.resize(base + stride * height, ' ');
+            char* slots = &out[base];
+
+            std::array<int, detail::kMaxKerningRows> inkEnd{};
+            int width = 0;
+            first = true;
+            for (size_t i = lineStart; i < lineEnd; i++) {
+                int g = detail::ResolveBigGlyph(font, text[i]);
+                if (g < 0) continue;
+                int w = font.width[g];
+                const char* glyph = font.atlas.data() + font.offset[g];
+
+                int x = first ? 0 : width + letterSpacing;
+                bool blank = true;
+                if (kerning) {
+                    int fitted = 0;
+                    for (int row = 0; row < height; row++) {
+                        const char* cells = glyph + row * w;
+                        int lead = 0;
+                        while (lead < w && cells[lead] == ' ') lead++;
+                        if (lead == w) continue;
+                        fitted = blank ? inkEnd[row] + letterSpacing - lead : std::max(fitted, inkEnd[row] + letterSpacing - lead);
+                        blank = false;
+                    }
+                    // A blank glyph (space) keeps its full width
+                    if (!first && !blank) x = std::max(0, std::min(x, fitted));
+                }
+
+                // Columns left of `width` may hold ink from earlier glyphs;
+                // kerning guarantees that only one side is non-blank there.
+                int overlap = std::max(0, std::min(w, width - x));
+                for (int row = 0; row < height; row++) {
+                    const char* cells = glyph + row * w;
+                    char* dest = slots + row * stride + glyphColumn + x;
+                    for (int c = 0; c < overlap; c++) {
+                        if (cells[c] != ' ') dest[c] = cells[c];
+                    }
+                    std::memcpy(dest + overlap, cells + overlap, w - overlap);
+
+                    if (kerning) {
+                        int trail = 0;
+                        while (trail < w && cells[w - 1 - trail] == ' ') trail++;
+                        if (trail < w) inkEnd[row] = x + w - trail;
+                        else if (blank) inkEnd[row] = x + w;
+                    }
+                }
+
+                width = std::max(width, x + w);
+                first = false;
+            }
+
+            int padding = center ? std::max(0, (centerWidth - width) / 2) : 0;
+
+            // Pack the slots: a packed row is never longer than its slot, so
+            // every row moves towards the front and nothing unread is overwritten.
+            char* dest = slots;
+            for (int row = 0; row < height; row++) {
+                const std::string* color = rowColors.empty() ? nullptr : &rowColors[row % rowColors.size()];
+                size_t colorLength = color ? color->size() : 0;
+                std::memmove(dest + colorLength + padding, slots + row * stride + glyphColumn, width);
+                if (color) std::memcpy(dest, color->data(), colorLength);
+                std::memset(dest + colorLength, ' ', padding);
+                dest += colorLength + padding + width;
+                if (color) {
+                    std::memcpy(dest, Color::RESET, resetLength);
+                    dest += resetLength;
+                }
+                *dest++ = '\n';
+            }
+            out.resize(dest - out.data());
+
+            lineStart = lineEnd + 1;
+        }
+    }
+
+    inline std::string RenderBigText(const std::string& text,
+        const BigFont& font = DefaultBigFont(),
+        int letterSpacing = 1,
+        bool center = false,
+        const std::vector<std::string>& rowColors = {},
+        bool kerning = false,
+        int centerWidth = 0)
+    {
+        std::string out;
+        RenderBigText(out, text, font, letterSpacing, center, rowColors, kerning, centerWidth);
+        return out;
+    }
+
+    inline void PrintBigText(const std::string& text,
+        bool center = false,
+        const std::vector<std::string>& rowColors = {},
+        const BigFont& font = DefaultBigFont(),
+        int letterSpacing = 1,
+        bool kerning = false)
+    {
+        std::string out;
+        RenderBigText(out, text, font, letterSpacing, center, rowColors, kerning);
+        std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+    }
+}
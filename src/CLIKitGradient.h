@@ -0,0 +1,200 @@
+#pragma once
+// 24-bit color gradients, with a 256-color fallback.
+#include "CLIKit.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CLIKit {
+
+    struct Rgb
+    {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+    };
+
+    // Detected once from COLORTERM (or Windows Terminal's WT_SESSION);
+    // override with CLIKIT_TRUECOLOR=0/1.
+    inline bool SupportsTrueColor()
+    {
+        static const bool supported = [] {
+            if (const char* env = std::getenv("CLIKIT_TRUECOLOR")) return env[0] == '1';
+            if (const char* colorTerm = std::getenv("COLORTERM")) {
+                std::string_view value(colorTerm);
+                if (value == "truecolor" || value == "24bit") return true;
+            }
+            return std::getenv("WT_SESSION") != nullptr;
+        }();
+        return supported;
+    }
+
+    // The Color rainbow (RED, ORANGE, YELLOW, GREEN, BLUE, PURPLE, CYAN) as RGB.
+    inline const std::vector<Rgb>& RainbowPalette()
+    {
+        static const std::vector<Rgb> palette = {
+            { 255, 0, 0 }, { 255, 135, 0 }, { 255, 215, 0 }, { 0, 200, 0 },
+            { 0, 95, 255 }, { 175, 0, 215 }, { 0, 215, 215 },
+        };
+        return palette;
+    }
+
+    // Nearest xterm 256-color index for an RGB color (6x6x6 cube or gray ramp).
+    inline int RgbTo256(Rgb color)
+    {
+        static constexpr int levels[6] = { 0, 95, 135, 175, 215, 255 };
+        auto nearestLevel = [](int v) {
+            int best = 0;
+            for (int i = 1; i < 6; i++) {
+                if (std::abs(levels[i] - v) < std::abs(levels[best] - v)) best = i;
+            }
+            return best;
+        };
+        int r = nearestLevel(color.r), g = nearestLevel(color.g), b = nearestLevel(color.b);
+        auto distance = [&](int cr, int cg, int cb) {
+            return (cr - color.r) * (cr - color.r) + (cg - color.g) * (cg - color.g) + (cb - color.b) * (cb - color.b);
+        };
+        int cubeDistance = distance(levels[r], levels[g], levels[b]);
+
+        int average = (color.r + color.g + color.b) / 3;
+        int grayIndex = std::min(23, std::max(0, (average - 8 + 5) / 10));
+        int gray = 8 + grayIndex * 10;
+        if (distance(gray, gray, gray) < cubeDistance) {
+            return 232 + grayIndex;
+        }
+        return 16 + 36 * r + 6 * g + b;
+    }
+
+    // Horizontal color gradient with every column's SGR sequence computed up
+    // front. Rendering a line is then one table lookup and two appends per
+    // character, and animating is just a different `offset` into the same table.
+    class Gradient
+    {
+    public:
+        // `cyclic` blends the last palette color back into the first so the
+        // gradient wraps seamlessly when shifted. Without truecolor support
+        // colors fall back to the nearest 256-color entry.
+        Gradient(const std::vector<Rgb>& palette,
+            int width,
+            bool cyclic = true,
+            bool trueColor = SupportsTrueColor())
+        {
+            if (width < 1) width = 1;
+            columns.reserve(static_cast<size_t>(width));
+
+            char buf[32];
+            for (int column = 0; column < width; column++) {
+                Rgb color = palette.empty() ? Rgb{ 255, 255, 255 } : Interpolate(palette, column, width, cyclic);
+                int len = trueColor
+                    ? std::snprintf(buf, sizeof(buf), "\033[38;2;%d;%d;%dm", color.r, color.g, color.b)
+                    : std::snprintf(buf, sizeof(buf), "\033[38;5;%dm", RgbTo256(color));
+
+                // Columns that map to the same sequence as their neighbour share it
+                std::string_view sequence(buf, static_cast<size_t>(len));
+                if (!columns.empty() && Sequence(column - 1) == sequence) {
+                    columns.push_back(columns.back());
+                    continue;
+                }
+                columns.push_back({ static_cast<uint32_t>(table.size()), static_cast<uint32_t>(len) });
+                table.append(buf, static_cast<size_t>(len));
+            }
+        }
+
+        int Width() const {
+            return static_cast<int>(columns.size());
+        }
+
+        // SGR sequence for a column (wraps around).
+        std::string_view Sequence(int column) const {
+            int width = static_cast<int>(columns.size());
+            const Entry& entry = columns[((column % width) + width) % width];
+            return std::string_view(table.data() + entry.start, entry.length);
+        }
+
+        // Appends `text` to `out`, column i colored with Sequence(i + offset).
+        // Newlines restart at column 0; UTF-8 continuation bytes stay with
+        // their character; a sequence is only emitted when the color changes.
+        void Render(std::string& out, std::string_view text, int offset = 0) const
+        {
+            int width = static_cast<int>(columns.size());
+            int column = ((offset % width) + width) % width;
+            uint32_t current = UINT32_MAX;
+            out.reserve(out.size() + text.size() * 8);
+
+            for (char c : text) {
+                unsigned char uc = static_cast<unsigned char>(c);
+                if (c == '\n') {
+                    out.push_back(c);
+                    column = ((offset % width) + width) % width;
+                    continue;
+                }
+                if ((uc & 0xC0) != 0x80) {
+                    const Entry& entry = columns[column];
+                    if (entry.start != current && c != ' ') {
+                        out.append(table.data() + entry.start, entry.length);
+                        current = entry.start;
+                    }
+                    if (++column == width) column = 0;
+                }
+                out.push_back(c);
+            }
+            out.append(Color::RESET);
+        }
+
+        std::string Apply(std::string_view text, int offset = 0) const
+        {
+            std::string out;
+            Render(out, text, offset);
+            return out;
+        }
+
+    private:
+        static Rgb Interpolate(const std::vector<Rgb>& palette, int column, int width, bool cyclic)
+        {
+            size_t count = palette.size();
+            if (count == 1) return palette[0];
+
+            // Position along the palette, in segments
+            double segments = cyclic ? static_cast<double>(count) : static_cast<double>(count - 1);
+            double position = width > 1
+                ? static_cast<double>(column) * segments / (cyclic ? width : width - 1)
+                : 0.0;
+            size_t index = static_cast<size_t>(position);
+            double t = position - static_cast<double>(index);
+            const Rgb& from = palette[index % count];
+            const Rgb& to = palette[(index + 1) % count];
+            if (!cyclic && index + 1 >= count) return palette[count - 1];
+
+            auto mix = [t](uint8_t a, uint8_t b) {
+                return static_cast<uint8_t>(a + (static_cast<double>(b) - a) * t + 0.5);
+            };
+            return { mix(from.r, to.r), mix(from.g, to.g), mix(from.b, to.b) };
+        }
+
+        struct Entry
+        {
+            uint32_t start;  // offset of the sequence in `table`
+            uint32_t length;
+        };
+
+        std::string table;          // distinct SGR sequences back to back
+        std::vector<Entry> columns; // one entry per column
+    };
+
+    // Prints `text` through a gradient in a single write.
+    inline void PrintGradient(std::string_view text, const Gradient& gradient, int offset = 0)
+    {
+        thread_local std::string buffer;
+        buffer.clear();
+        gradient.Render(buffer, text, offset);
+        buffer.push_back('\n');
+        std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        std::cout.flush();
+    }
+}
@@ -0,0 +1,173 @@
+#pragma once
+// JSON-lines output for the Print* family, and the JSON string escaping
+// it shares with SessionRecorder.
+#include "CLIKit.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <initializer_list>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+namespace CLIKit {
+
+    namespace detail {
+        // True if any of the 8 bytes in `v` is a control char, '"' or '\\'.
+        // Bit tricks on a 64-bit word stand in for SIMD compares.
+        inline bool JsonBlockNeedsEscape(uint64_t v)
+        {
+            constexpr uint64_t ones = 0x0101010101010101ULL;
+            constexpr uint64_t highs = 0x8080808080808080ULL;
+            auto hasZero = [](uint64_t x) { return ((x - ones) & ~x & highs) != 0; };
+            bool hasControl = ((v - ones * 0x20) & ~v & highs) != 0;
+            return hasControl || hasZero(v ^ (ones * '"')) || hasZero(v ^ (ones * '\\'));
+        }
+
+        // Appends `data` as the body of a JSON string (without the quotes).
+        // With `crlf`, every newline is stored as "\r\n".
+        inline void AppendJsonEscaped(std::string& out, const char* data, size_t size, bool crlf = false)
+        {
+            static constexpr char hex[] = "0123456789abcdef";
+            size_t runStart = 0;
+            for (size_t i = 0; i < size; i++) {
+                // Skip over clean 8-byte blocks without looking at each byte
+                while (i + 8 <= size) {
+                    uint64_t block;
+                    std::memcpy(&block, data + i, 8);
+                    if (JsonBlockNeedsEscape(block)) break;
+                    i += 8;
+                }
+                if (i >= size) break;
+
+                unsigned char c = static_cast<unsigned char>(data[i]);
+                if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+                // Copy the clean run in one go, then the escape
+                out.append(data + runStart, i - runStart);
+                runStart = i + 1;
+                switch (c) {
+                case '"':  out.append("\\\""); break;
+                case '\\': out.append("\\\\"); break;
+                case '\n': out.append(crlf ? "\\r\\n" : "\\n"); break;
+                case '\r': out.append("\\r"); break;
+                case '\t': out.append("\\t"); break;
+                default:
+                    out.append("\\u00");
+                    out.push_back(hex[c >> 4]);
+                    out.push_back(hex[c & 0xF]);
+                    break;
+                }
+            }
+            out.append(data + runStart, size - runStart);
+        }
+
+        // Collects JSON-lines records and writes them to std::cout in batches.
+        struct JsonLinesWriter
+        {
+            std::mutex mutex;
+            std::string buffer;
+            size_t batchBytes = 0;        // 0 = write every record immediately
+            std::time_t cachedSecond = -1;
+            char cachedPrefix[32] = {};   // "YYYY-MM-DDTHH:MM:SS" for cachedSecond
+
+            ~JsonLinesWriter() {
+                std::lock_guard<std::mutex> lock(mutex);
+                FlushLocked();
+            }
+
+            void FlushLocked() {
+                if (buffer.empty()) return;
+                std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                std::cout.flush();
+                buffer.clear();
+            }
+
+            // ISO 8601 UTC with microseconds; the date part is only
+            // reformatted when the second changes.
+            void AppendTimestamp() {
+                using namespace std::chrono;
+                auto micros = duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+                std::time_t second = static_cast<std::time_t>(micros / 1000000);
+                if (second != cachedSecond) {
+                    std::tm utc;
+#ifdef _WIN32
+                    gmtime_s(&utc, &second);
+#else
+                    gmtime_r(&second, &utc);
+#endif
+                    std::strftime(cachedPrefix, sizeof(cachedPrefix), "%Y-%m-%dT%H:%M:%S", &utc);
+                    cachedSecond = second;
+                }
+                buffer.append(cachedPrefix);
+
+                char fraction[9] = { '.', '0', '0', '0', '0', '0', '0', 'Z', '\0' };
+                long long rest = micros % 1000000;
+                for (int i = 6; i >= 1; i--) {
+                    fraction[i] = static_cast<char>('0' + rest % 10);
+                    rest /= 10;
+                }
+                buffer.append(fraction, 8);
+            }
+        };
+
+        inline JsonLinesWriter jsonLines;
+
+        inline void WriteLogRecord(const char* level,
+            const std::string& msg,
+            std::initializer_list<LogField> fields,
+            bool flushNow)
+        {
+            std::lock_guard<std::mutex> lock(jsonLines.mutex);
+            std::string& out = jsonLines.buffer;
+
+            out.append("{\"ts\":\"");
+            jsonLines.AppendTimestamp();
+            out.append("\",\"level\":\"");
+            out.append(level);
+            out.append("\",\"msg\":\"");
+            AppendJsonEscaped(out, msg.data(), msg.size());
+            out.push_back('"');
+
+            for (const auto& field : fields) {
+                out.append(",\"");
+                AppendJsonEscaped(out, field.key.data(), field.key.size());
+                out.append("\":");
+                if (field.value.quoted) out.push_back('"');
+                AppendJsonEscaped(out, field.value.data, field.value.size);
+                if (field.value.quoted) out.push_back('"');
+            }
+            out.append("}\n");
+
+            if (flushNow || out.size() >= jsonLines.batchBytes) {
+                jsonLines.FlushLocked();
+            }
+        }
+    }
+
+    // Selects how the Print* family writes. JsonLines writes one JSON object
+    // per line ({"ts", "level", "msg"} plus any fields) without colors.
+    inline void SetOutputMode(OutputMode mode) {
+        detail::outputMode.store(mode, std::memory_order_relaxed);
+        detail::logRecordWriter.store(mode == OutputMode::JsonLines ? &detail::WriteLogRecord : nullptr,
+            std::memory_order_release);
+    }
+
+    // In JsonLines mode, records are kept in memory until `bytes` have
+    // accumulated (0, the default, writes each record at once). Errors and
+    // FlushOutput() always write the batch, and so does program exit.
+    inline void SetJsonBatchSize(size_t bytes) {
+        std::lock_guard<std::mutex> lock(detail::jsonLines.mutex);
+        detail::jsonLines.batchBytes = bytes;
+    }
+
+    inline void FlushOutput() {
+        {
+            std::lock_guard<std::mutex> lock(detail::jsonLines.mutex);
+            detail::jsonLines.FlushLocked();
+        }
+        std::cout.flush();
+    }
+}
@@ -0,0 +1,258 @@
+#pragma once
+// Rich-text markup such as "[bold red]ERROR[/] disk {0} full", compiled
+// once into SGR templates.
+#include "CLIKit.h"
+
+#include <charconv>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace CLIKit {
+
+    namespace detail {
+        // Looks up a markup style name ("bold", "red", "light_cyan", "#ff8800").
+        inline bool MarkupStyle(std::string_view name, std::string& sgr)
+        {
+            struct NamedStyle { const char* name; const char* sgr; };
+            static constexpr NamedStyle styles[] = {
+                { "bold", "\033[1m" }, { "dim", "\033[2m" }, { "italic", "\033[3m" },
+                { "underline", "\033[4m" }, { "blink", "\033[5m" }, { "reverse", "\033[7m" },
+                { "strike", "\033[9m" },
+                { "red", Color::RED }, { "orange", Color::ORANGE }, { "yellow", Color::YELLOW },
+                { "green", Color::GREEN }, { "blue", Color::BLUE }, { "purple", Color::PURPLE },
+                { "cyan", Color::CYAN }, { "white", Color::WHITE }, { "gray", Color::GRAY },
+                { "black", Color::BLACK },
+                { "light_red", Color::LIGHT_RED }, { "light_orange", Color::LIGHT_ORANGE },
+                { "light_yellow", Color::LIGHT_YELLOW }, { "light_green", Color::LIGHT_GREEN },
+                { "light_blue", Color::LIGHT_BLUE }, { "light_purple", Color::LIGHT_PURPLE },
+                { "light_cyan", Color::LIGHT_CYAN },
+            };
+            for (const auto& style : styles) {
+                if (name == style.name) {
+                    sgr.append(style.sgr);
+                    return true;
+                }
+            }
+
+            // Truecolor: #rrggbb
+            if (name.size() == 7 && name[0] == '#') {
+                for (size_t i = 1; i < 7; i++) {
+                    if (!std::isxdigit(static_cast<unsigned char>(name[i]))) return false;
+                }
+                unsigned long rgb = std::strtoul(std::string(name.substr(1)).c_str(), nullptr, 16);
+                sgr.append("\033[38;2;" + std::to_string(rgb >> 16) + ";" + std::to_string((rgb >> 8) & 0xFF)
+                    + ";" + std::to_string(rgb & 0xFF) + "m");
+                return true;
+            }
+            return false;
+        }
+    }
+
+    // Rich-text template such as "[bold red]ERROR[/] disk {0} full".
+    // Parsing happens once, in the constructor: style tags become literal SGR
+    // bytes and the template is reduced to a list of literal slices and
+    // argument slots, so rendering is a sequence of appends.
+    //
+    //   [style ...]  open styles: bold dim italic underline blink reverse strike,
+    //                the Color names in lower case (red, light_cyan, ...) or #rrggbb
+    //   [/]          close the last opened tag; [/name] closes it too if `name`
+    //                is one of its styles
+    //   {0} {1} {}   argument slots, {} takes the next argument
+    //   [[ {{ }}     literal [ { }
+    //
+    // Unknown tags, and closing tags that match no open tag, are kept as
+    // plain text so "[1/3]" and "[/var/log]" print as-is.
+    class CompiledMarkup
+    {
+    public:
+        explicit CompiledMarkup(std::string_view markup)
+            : source(markup)
+        {
+            struct OpenTag
+            {
+                std::string_view names; // e.g. "bold red"
+                std::string sgr;
+            };
+            std::vector<OpenTag> stack;
+            int nextArg = 0;
+
+            size_t i = 0;
+            while (i < source.size()) {
+                char c = source[i];
+
+                if ((c == '[' || c == '{' || c == '}') && i + 1 < source.size() && source[i + 1] == c) {
+                    AddLiteral(&c, 1);
+                    i += 2;
+                    continue;
+                }
+
+                if (c == '{') {
+                    size_t close = source.find('}', i);
+                    if (close != std::string::npos) {
+                        std::string_view inside(source.data() + i + 1, close - i - 1);
+                        int index = -1;
+                        if (inside.empty()) {
+                            index = nextArg++;
+                        }
+                        else if (inside.find_first_not_of("0123456789") == std::string_view::npos) {
+                            int value = 0;
+                            auto result = std::from_chars(inside.data(), inside.data() + inside.size(), value);
+                            if (result.ec == std::errc()) index = value; // out of range stays text
+                        }
+                        if (index >= 0) {
+                            segments.push_back({ 0, 0, index });
+                            i = close + 1;
+                            continue;
+                        }
+                    }
+                }
+
+                if (c == '[') {
+                    size_t close = source.find(']', i);
+                    if (close != std::string::npos) {
+                        std::string_view tag(source.data() + i + 1, close - i - 1);
+                        if (!tag.empty() && tag[0] == '/' && !stack.empty() && ClosesTag(tag.substr(1), stack.back().names)) {
+                            stack.pop_back();
+                            // Reset, then re-apply whatever is still open
+                            AddLiteral(Color::RESET, std::strlen(Color::RESET));
+                            for (const auto& open : stack) AddLiteral(open.sgr.data(), open.sgr.size());
+                            i = close + 1;
+                            continue;
+                        }
+
+                        std::string sgr;
+                        bool known = !tag.empty() && tag[0] != '/';
+                        size_t pos = 0;
+                        while (known && pos < tag.size()) {
+                            size_t end = tag.find(' ', pos);
+                            if (end == std::string_view::npos) end = tag.size();
+                            if (end > pos) known = detail::MarkupStyle(tag.substr(pos, end - pos), sgr);
+                            pos = end + 1;
+                        }
+                        if (known) {
+                            AddLiteral(sgr.data(), sgr.size());
+                            stack.push_back({ tag, std::move(sgr) });
+                            i = close + 1;
+                            continue;
+                        }
+                    }
+                }
+
+                AddLiteral(&c, 1);
+                i++;
+            }
+
+            if (!stack.empty()) {
+                AddLiteral(Color::RESET, std::strlen(Color::RESET));
+            }
+        }
+
+        const std::string& Source() const {
+            return source;
+        }
+
+        // Appends the rendered text to `out`; missing arguments render as nothing.
+        template<typename... Args>
+        void Render(std::string& out, const Args&... args) const
+        {
+            const detail::FormatArg values[sizeof...(Args) + 1] = { detail::FormatArg(args)..., detail::FormatArg("") };
+            for (const auto& segment : segments) {
+                if (segment.arg < 0) {
+                    out.append(literals.data() + segment.offset, segment.length);
+                }
+                else if (static_cast<size_t>(segment.arg) < sizeof...(Args)) {
+                    out.append(values[segment.arg].data, values[segment.arg].size);
+                }
+            }
+        }
+
+        template<typename... Args>
+        std::string Format(const Args&... args) const
+        {
+            std::string out;
+            out.reserve(literals.size() + 16 * sizeof...(Args));
+            Render(out, args...);
+            return out;
+        }
+
+    private:
+        struct Segment
+        {
+            size_t offset;
+            size_t length;
+            int arg; // -1 for a literal slice
+        };
+
+        // True if `[/name]` closes the tag `[names]`: an empty name, the
+        // whole tag or one of its styles.
+        static bool ClosesTag(std::string_view name, std::string_view names)
+        {
+            if (name.empty() || name == names) return true;
+            size_t pos = 0;
+            while (pos < names.size()) {
+                size_t end = names.find(' ', pos);
+                if (end == std::string_view::npos) end = names.size();
+                if (names.substr(pos, end - pos) == name) return true;
+                pos = end + 1;
+            }
+            return false;
+        }
+
+        void AddLiteral(const char* data, size_t size) {
+            // Merge with the previous literal slice when possible
+            if (!segments.empty() && segments.back().arg < 0 && segments.back().offset + segments.back().length == literals.size()) {
+                segments.back().length += size;
+            }
+            else {
+                segments.push_back({ literals.size(), size, -1 });
+            }
+            literals.append(data, size);
+        }
+
+        std::string source;
+        std::string literals;
+        std::vector<Segment> segments;
+    };
+
+    // Returns the compiled template for `markup`, compiling it on first use.
+    // The cache is per thread, so lookups take no lock. It is emptied when it
+    // grows past 256 templates, so markup built at runtime cannot grow it
+    // without bound; the reference is only good until the next call. Keep a
+    // CompiledMarkup of your own to hold on to one.
+    inline const CompiledMarkup& GetCompiledMarkup(std::string_view markup)
+    {
+        constexpr size_t kMaxCacheEntries = 256;
+
+        // Keys view into each entry's own copy of the source
+        thread_local std::unordered_map<std::string_view, std::unique_ptr<CompiledMarkup>> cache;
+
+        auto it = cache.find(markup);
+        if (it != cache.end()) {
+            return *it->second;
+        }
+        if (cache.size() >= kMaxCacheEntries) cache.clear();
+        auto compiled = std::make_unique<CompiledMarkup>(markup);
+        const CompiledMarkup& ref = *compiled;
+        cache.emplace(std::string_view(ref.Source()), std::move(compiled));
+        return ref;
+    }
+
+    template<typename... Args>
+    std::string Markup(std::string_view markup, const Args&... args)
+    {
+        return GetCompiledMarkup(markup).Format(args...);
+    }
+
+    template<typename... Args>
+    void PrintMarkup(std::string_view markup, const Args&... args)
+    {
+        thread_local std::string buffer;
+        buffer.clear();
+        GetCompiledMarkup(markup).Render(buffer, args...);
+        buffer.push_back('\n');
+        std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+}
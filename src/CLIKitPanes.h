@@ -0,0 +1,410 @@
+#pragma once
+// PaneLayout: splits the terminal into independently scrolling panes.
+#include "CLIKit.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#ifndef _WIN32
+#include <csignal>
+#endif
+
+namespace CLIKit {
+
+    class PaneLayout;
+
+    namespace detail {
+        // PaneLayout that Print* output is routed to (see PaneLayout::RouteLogs).
+        // Changed and used under activeLayoutMutex, so a layout cannot be
+        // destroyed while a log line is being routed to it.
+        inline std::atomic<PaneLayout*> activeLayout{ nullptr };
+        inline std::mutex activeLayoutMutex;
+        inline std::atomic<bool> resizePending{ false };
+        inline bool RouteLogLine(const std::string& line);
+
+        // Fixed-capacity line history; the oldest line is dropped when full.
+        class LineRing
+        {
+        public:
+            explicit LineRing(size_t capacity = 1)
+                : lines(std::max<size_t>(1, capacity)) {}
+
+            void Push(std::string_view line) {
+                size_t slot = (head + count) % lines.size();
+                if (count == lines.size()) {
+                    head = (head + 1) % lines.size();
+                }
+                else {
+                    count++;
+                }
+                lines[slot].assign(line.data(), line.size());
+            }
+
+            size_t Size() const { return count; }
+            size_t Capacity() const { return lines.size(); }
+
+            // 0 = oldest line kept
+            std::string& operator[](size_t index) { return lines[(head + index) % lines.size()]; }
+            const std::string& operator[](size_t index) const { return lines[(head + index) % lines.size()]; }
+
+            void Clear() {
+                head = 0;
+                count = 0;
+            }
+
+        private:
+            std::vector<std::string> lines;
+            size_t head = 0;
+            size_t count = 0;
+        };
+
+        // Appends `text` cut to `width` visible columns; escape sequences and
+        // UTF-8 continuation bytes don't count towards the width.
+        inline void AppendVisible(std::string& out, std::string_view text, int width)
+        {
+            int column = 0;
+            size_t i = 0;
+            while (i < text.size()) {
+                unsigned char c = static_cast<unsigned char>(text[i]);
+                if (c == 0x1B && i + 1 < text.size() && text[i + 1] == '[') {
+                    size_t end = i + 2;
+                    while (end < text.size() && !(text[end] >= 0x40 && text[end] <= 0x7E)) end++;
+                    out.append(text.data() + i, std::min(end + 1, text.size()) - i);
+                    i = end + 1;
+                    continue;
+                }
+                if (c == '\n' || c == '\r') {
+                    i++;
+                    continue;
+                }
+                if ((c & 0xC0) != 0x80) {
+                    if (column == width) break;
+                    column++;
+                }
+                out.push_back(text[i]);
+                i++;
+            }
+        }
+
+#ifndef _WIN32
+        inline void OnResizeSignal(int) {
+            resizePending.store(true);
+        }
+#endif
+    }
+
+    // Splits the terminal into panes stacked top to bottom, e.g. a status
+    // header, a scrolling log and a few pinned progress bars. Appending to a
+    // pane sets the terminal scroll region (DECSTBM) to that pane's rows and
+    // lets the terminal scroll it, so nothing else is repainted. Every pane
+    // keeps a bounded scrollback used to repaint after a resize.
+    // All member functions may be called from any thread.
+    //
+    //   CLIKit::PaneLayout layout;
+    //   int status = layout.AddPane(1);
+    //   int log = layout.AddPane();        // takes the remaining rows
+    //   int bars = layout.AddPane(2);
+    //   layout.RouteLogs(log);             // PrintInfo & co. now land in `log`
+    class PaneLayout
+    {
+    public:
+        PaneLayout() {
+            EnableVirtualTerminal();
+#ifndef _WIN32
+            struct sigaction action {};
+            action.sa_handler = detail::OnResizeSignal;
+            action.sa_flags = SA_RESTART; // don't break blocking reads on resize
+            sigemptyset(&action.sa_mask);
+            sigaction(SIGWINCH, &action, &previousResizeAction);
+#endif
+            width = GetTerminalWidth();
+            height = GetTerminalHeight();
+        }
+
+        ~PaneLayout() {
+            {
+                // Waits for a log line that is being routed here
+                std::lock_guard<std::mutex> routeLock(detail::activeLayoutMutex);
+                if (detail::activeLayout.load() == this) detail::activeLayout.store(nullptr);
+            }
+#ifndef _WIN32
+            sigaction(SIGWINCH, &previousResizeAction, nullptr);
+#endif
+            std::lock_guard<std::mutex> lock(mutex);
+            // Full-screen scroll region again, cursor below everything
+            Frame frame;
+            frame << "\033[r";
+            frame.MoveTo(height, 1);
+            frame << "\n";
+        }
+
+        PaneLayout(const PaneLayout&) = delete;
+        PaneLayout& operator=(const PaneLayout&) = delete;
+
+        // Adds a pane below the existing ones and returns its index.
+        // `rows` > 0 gives a fixed height; 0 shares the rows left over by
+        // fixed panes. `scrollback` is how many lines the pane remembers.
+        int AddPane(int rows = 0, size_t scrollback = 1000)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            Pane pane;
+            pane.fixedRows = std::max(0, rows);
+            pane.lines = detail::LineRing(std::max<size_t>(scrollback, static_cast<size_t>(pane.fixedRows)));
+            panes.push_back(std::move(pane));
+            Reflow();
+            RedrawLocked();
+            return static_cast<int>(panes.size()) - 1;
+        }
+
+        // Adds a line at the bottom of the pane, scrolling it up when full.
+        void Append(int pane, std::string_view line)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!ValidPane(pane)) return;
+            CheckResizeLocked();
+
+            Pane& p = panes[pane];
+            p.lines.Push(line);
+            if (p.rows <= 0) {
+                p.shown = std::min(p.shown + 1, VisibleRows(p));
+                return;
+            }
+
+            Frame frame;
+            frame << "\0337"; // save cursor
+            if (p.shown < p.rows) {
+                // Pane not full yet: just use the next empty row
+                frame.MoveTo(p.top + p.shown, 1);
+                p.shown++;
+            }
+            else {
+                // Scroll only this pane's rows, then write on its last row
+                frame << "\033[" << p.top << ";" << (p.top + p.rows - 1) << "r";
+                frame.MoveTo(p.top + p.rows - 1, 1);
+                frame << "\n\r\033[r";
+                frame.MoveTo(p.top + p.rows - 1, 1);
+            }
+            frame << "\033[2K";
+            detail::AppendVisible(frame.Buffer(), line, width);
+            frame << Color::RESET << "\0338"; // restore cursor
+        }
+
+        // Replaces one visible row of a pane, e.g. a status line or a
+        // progress bar. Rows count from the top of the pane. Rows below the
+        // last line shown are filled with empty lines first, so the history
+        // stays in screen order and a later Append goes below this row.
+        void SetLine(int pane, int row, std::string_view text)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!ValidPane(pane)) return;
+            CheckResizeLocked();
+
+            Pane& p = panes[pane];
+            if (row < 0 || row >= VisibleRows(p)) return;
+
+            if (row >= p.shown) {
+                for (int i = p.shown; i < row; i++) p.lines.Push("");
+                p.lines.Push(text);
+                p.shown = row + 1;
+            }
+            else {
+                // Rows 0..shown-1 show the newest `shown` lines
+                size_t fromNewest = static_cast<size_t>(p.shown - row);
+                if (fromNewest <= p.lines.Size()) {
+                    p.lines[p.lines.Size() - fromNewest].assign(text.data(), text.size());
+                }
+            }
+
+            if (row >= p.rows) return;
+            Frame frame;
+            frame << "\0337";
+            frame.MoveTo(p.top + row, 1);
+            frame << "\033[2K";
+            detail::AppendVisible(frame.Buffer(), text, width);
+            frame << Color::RESET << "\0338";
+        }
+
+        void Clear(int pane)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!ValidPane(pane)) return;
+            Pane& p = panes[pane];
+            p.lines.Clear();
+            p.shown = 0;
+            if (p.rows <= 0) return;
+
+            Frame frame;
+            frame << "\0337";
+            for (int row = 0; row < p.rows; row++) {
+                frame.MoveTo(p.top + row, 1);
+                frame << "\033[2K";
+            }
+            frame << "\0338";
+        }
+
+        // Sends PrintInfo/PrintWarning/PrintError/PrintSuccess output to
+        // `pane` while this layout lives (-1 to stop).
+        void RouteLogs(int pane)
+        {
+            std::lock_guard<std::mutex> routeLock(detail::activeLayoutMutex);
+            logPane = pane;
+            detail::logRouter.store(&detail::RouteLogLine, std::memory_order_release);
+            if (pane >= 0 && !detail::activeLayout.load()) {
+                detail::activeLayout.store(this);
+            }
+            else if (pane < 0 && detail::activeLayout.load() == this) {
+                detail::activeLayout.store(nullptr);
+            }
+        }
+
+        int LogPane() const {
+            return logPane;
+        }
+
+        // Re-reads the terminal size and repaints if it changed. Called by
+        // Append/SetLine; on POSIX it only costs an atomic load unless a
+        // SIGWINCH arrived.
+        bool CheckResize()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return CheckResizeLocked();
+        }
+
+        // Repaints every pane from its scrollback.
+        void Redraw()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            RedrawLocked();
+        }
+
+        int Width() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return width;
+        }
+
+        int Height() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return height;
+        }
+
+        // First row (1-based) and number of rows currently given to a pane.
+        int PaneTop(int pane) const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return ValidPane(pane) ? panes[pane].top : 0;
+        }
+
+        int PaneRows(int pane) const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return ValidPane(pane) ? panes[pane].rows : 0;
+        }
+
+    private:
+        struct Pane
+        {
+            int fixedRows = 0;
+            int top = 1;
+            int rows = 0;
+            int shown = 0; // top rows holding the newest `shown` lines
+            detail::LineRing lines;
+        };
+
+        bool ValidPane(int pane) const {
+            return pane >= 0 && static_cast<size_t>(pane) < panes.size();
+        }
+
+        // Rows the pane would have on screen; fixed panes keep their size
+        // while the terminal is too small to show them.
+        static int VisibleRows(const Pane& p) {
+            return p.rows > 0 ? p.rows : p.fixedRows;
+        }
+
+        bool CheckResizeLocked()
+        {
+#ifndef _WIN32
+            if (!detail::resizePending.exchange(false)) return false;
+#endif
+            int newWidth = GetTerminalWidth();
+            int newHeight = GetTerminalHeight();
+            if (newWidth == width && newHeight == height) return false;
+
+            width = newWidth;
+            height = newHeight;
+            Reflow();
+            RedrawLocked();
+            return true;
+        }
+
+        void RedrawLocked()
+        {
+            Frame frame;
+            frame << "\0337\033[r\033[2J";
+            for (Pane& p : panes) {
+                size_t size = p.lines.Size();
+                p.shown = static_cast<int>(std::min(size, static_cast<size_t>(VisibleRows(p))));
+                size_t visible = std::min(size, static_cast<size_t>(std::max(0, p.rows)));
+                size_t first = size - visible; // newest lines
+                for (size_t i = 0; i < visible; i++) {
+                    frame.MoveTo(p.top + static_cast<int>(i), 1);
+                    detail::AppendVisible(frame.Buffer(), p.lines[first + i], width);
+                    frame << Color::RESET;
+                }
+            }
+            frame << "\0338";
+        }
+
+        // Hands out rows: fixed panes first, the rest split between flexible ones.
+        void Reflow()
+        {
+            int fixedTotal = 0;
+            int flexible = 0;
+            for (const Pane& p : panes) {
+                if (p.fixedRows > 0) fixedTotal += p.fixedRows;
+                else flexible++;
+            }
+
+            int spare = std::max(0, height - fixedTotal);
+            int top = 1;
+            int flexibleSeen = 0;
+            for (Pane& p : panes) {
+                int rows;
+                if (p.fixedRows > 0) {
+                    rows = p.fixedRows;
+                }
+                else {
+                    flexibleSeen++;
+                    rows = spare / flexible + (flexibleSeen == flexible ? spare % flexible : 0);
+                }
+                // Never go past the bottom of the screen
+                rows = std::max(0, std::min(rows, height - top + 1));
+                p.top = top;
+                p.rows = rows;
+                top += rows;
+            }
+        }
+
+        mutable std::mutex mutex; // guards everything below
+        std::vector<Pane> panes;
+        int width = 80;
+        int height = 24;
+        std::atomic<int> logPane{ -1 };
+#ifndef _WIN32
+        struct sigaction previousResizeAction {};
+#endif
+    };
+
+    namespace detail {
+        inline bool RouteLogLine(const std::string& line)
+        {
+            // Lock-free check first, so logging without a layout costs nothing
+            if (!activeLayout.load(std::memory_order_acquire)) return false;
+
+            std::lock_guard<std::mutex> routeLock(activeLayoutMutex);
+            PaneLayout* layout = activeLayout.load(std::memory_order_relaxed);
+            if (!layout || layout->LogPane() < 0) return false;
+            layout->Append(layout->LogPane(), line);
+            return true;
+        }
+    }
+}
@@ -0,0 +1,269 @@
+#pragma once
+// ProgressTracker and Track(): progress bars with rate and ETA for loops.
+#include "CLIKit.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace CLIKit {
+
+    // Thread-safe progress counter that draws a ProgressBar with rate and ETA.
+    // Tick() is an atomic add and one compare; the clock is only read once the
+    // count reaches the next point where the bar could change (next percent)
+    // or where roughly one redraw interval has passed at the current rate,
+    // and at least every kMaxCheckStride ticks so a slowdown is noticed.
+    // Pass total = 0 when the number of items is unknown.
+    class ProgressTracker
+    {
+    public:
+        explicit ProgressTracker(size_t total,
+            const std::string& label = "",
+            int barWidth = 40,
+            int redrawIntervalMs = 100)
+            : total(total),
+              label(label),
+              barWidth(barWidth),
+              redrawInterval(std::chrono::milliseconds(redrawIntervalMs)),
+              start(std::chrono::steady_clock::now()),
+              lastSample(start),
+              lastDraw(start)
+        {
+            Draw(0, start);
+        }
+
+        ~ProgressTracker() {
+            Finish();
+        }
+
+        ProgressTracker(const ProgressTracker&) = delete;
+        ProgressTracker& operator=(const ProgressTracker&) = delete;
+
+        void Tick(size_t n = 1) {
+            size_t done = count.fetch_add(n, std::memory_order_relaxed) + n;
+            if (done >= nextCheck.load(std::memory_order_relaxed)) {
+                Update(done);
+            }
+        }
+
+        size_t Count() const {
+            return count.load(std::memory_order_relaxed);
+        }
+
+        // Draws the final state and moves to the next line. Called by the
+        // destructor; further ticks are still counted but not drawn.
+        void Finish() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (finished) return;
+            finished = true;
+            nextCheck.store(std::numeric_limits<size_t>::max(), std::memory_order_relaxed);
+            Draw(count.load(std::memory_order_relaxed), std::chrono::steady_clock::now());
+            std::cout << "\n" << std::flush;
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void Update(size_t done) {
+            // Another thread is already drawing; it will pick up our count
+            std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+            if (!lock.owns_lock() || finished) return;
+
+            auto now = Clock::now();
+            double dt = std::chrono::duration<double>(now - lastSample).count();
+            if (dt >= 0.02) {
+                // Exponentially weighted moving average of items per second,
+                // weighted by the time each sample covers so that a long gap
+                // replaces an estimate that no longer holds
+                double instant = static_cast<double>(done - lastSampleCount) / dt;
+                double weight = std::min(1.0, dt / (3.0 * std::chrono::duration<double>(redrawInterval).count()));
+                rate = rate > 0.0 ? rate + weight * (instant - rate) : instant;
+                lastSample = now;
+                lastSampleCount = done;
+            }
+
+            if (PercentOf(done) != lastPercent || now - lastDraw >= redrawInterval) {
+                Draw(done, now);
+            }
+
+            // Check again at the next percent step, or after about one
+            // redraw interval's worth of items, whichever comes first.
+            // Until there is a rate estimate, back off by doubling. The rate
+            // may be stale if items slowed down, so never skip too far.
+            size_t stride = rate > 0.0
+                ? static_cast<size_t>(rate * std::chrono::duration<double>(redrawInterval).count())
+                : done;
+            size_t next = done + std::clamp<size_t>(stride, 1, kMaxCheckStride);
+            if (total > 0 && lastPercent < 100) {
+                size_t nextPercentAt = (static_cast<size_t>(lastPercent + 1) * total + 99) / 100;
+                next = std::min(next, std::max(nextPercentAt, done + 1));
+            }
+            nextCheck.store(next, std::memory_order_relaxed);
+        }
+
+        int PercentOf(size_t done) const {
+            if (total == 0) return -1;
+            return static_cast<int>(std::min(done, total) * 100 / total);
+        }
+
+        static void AppendRate(std::string& out, double value) {
+            static constexpr const char* units[] = { "", "k", "M", "G" };
+            int unit = 0;
+            while (value >= 1000.0 && unit < 3) {
+                value /= 1000.0;
+                unit++;
+            }
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), " %.1f%s it/s", value, units[unit]);
+            out.append(buf);
+        }
+
+        static void AppendDuration(std::string& out, double seconds) {
+            long long s = static_cast<long long>(seconds + 0.5);
+            char buf[32];
+            if (s >= 3600) std::snprintf(buf, sizeof(buf), "%lld:%02lld:%02lld", s / 3600, (s / 60) % 60, s % 60);
+            else std::snprintf(buf, sizeof(buf), "%02lld:%02lld", s / 60, s % 60);
+            out.append(buf);
+        }
+
+        void Draw(size_t done, Clock::time_point now) {
+            lastDraw = now;
+            lastPercent = PercentOf(done);
+
+            line.assign("\r");
+            if (total > 0) {
+                // ProgressBar takes ints; scale large totals down to percent steps
+                int current = total <= static_cast<size_t>(std::numeric_limits<int>::max()) ? static_cast<int>(std::min(done, total)) : lastPercent;
+                int max = total <= static_cast<size_t>(std::numeric_limits<int>::max()) ? static_cast<int>(total) : 100;
+                line.append(ProgressBar(current, max, barWidth, label.empty() ? "" : label + " ", "", "=", "-",
+                    Color::GREEN, Color::GRAY, Color::WHITE, Color::LIGHT_GREEN,
+                    Color::WHITE, Color::LIGHT_BLUE, true, true, false));
+            }
+            else {
+                if (!label.empty()) line.append(Color::LIGHT_GREEN).append(label).append(" ");
+                line.append(Color::WHITE).append(std::to_string(done)).append(" it");
+            }
+
+            line.append(Color::GRAY);
+            double elapsed = std::chrono::duration<double>(now - start).count();
+            double average = elapsed > 0.0 ? static_cast<double>(done) / elapsed : 0.0;
+            double shownRate = finished || rate <= 0.0 ? average : rate;
+            AppendRate(line, shownRate);
+            if (finished || (total > 0 && done >= total)) {
+                line.append(" in ");
+                AppendDuration(line, elapsed);
+            }
+            else if (total > 0 && shownRate > 0.0) {
+                line.append(" ETA ");
+                AppendDuration(line, static_cast<double>(total - done) / shownRate);
+            }
+            line.append(Color::RESET).append("\033[K"); // clear leftovers of a longer previous line
+
+            if (line == shown) return;
+            std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+            std::cout.flush();
+            line.swap(shown);
+        }
+
+        static constexpr size_t kMaxCheckStride = 16;
+
+        const size_t total;
+        const std::string label;
+        const int barWidth;
+        const Clock::duration redrawInterval;
+        const Clock::time_point start;
+
+        std::atomic<size_t> count{ 0 };
+        std::atomic<size_t> nextCheck{ 1 };
+
+        // Guarded by mutex
+        std::mutex mutex;
+        Clock::time_point lastSample;
+        size_t lastSampleCount = 0;
+        Clock::time_point lastDraw;
+        int lastPercent = -1;
+        double rate = 0.0;
+        bool finished = false;
+        std::string line;
+        std::string shown; // last line written
+    };
+
+    namespace detail {
+        template<typename Range, typename = void>
+        struct HasSize : std::false_type {};
+
+        template<typename Range>
+        struct HasSize<Range, std::void_t<decltype(std::size(std::declval<Range&>()))>> : std::true_type {};
+    }
+
+    // Range wrapper returned by Track(); ticks its tracker as the loop advances.
+    template<typename Range>
+    class TrackedRange
+    {
+    public:
+        using BaseIterator = decltype(std::begin(std::declval<Range&>()));
+
+        class iterator
+        {
+        public:
+            iterator(BaseIterator it, ProgressTracker* tracker) : it(it), tracker(tracker) {}
+
+            decltype(auto) operator*() const { return *it; }
+
+            iterator& operator++() {
+                ++it;
+                tracker->Tick();
+                return *this;
+            }
+
+            bool operator!=(const iterator& other) const { return it != other.it; }
+            bool operator==(const iterator& other) const { return it == other.it; }
+
+        private:
+            BaseIterator it;
+            ProgressTracker* tracker;
+        };
+
+        TrackedRange(Range&& range, const std::string& label, int barWidth, int redrawIntervalMs)
+            : range(std::forward<Range>(range)),
+              tracker(SizeOf(this->range), label, barWidth, redrawIntervalMs) {}
+
+        iterator begin() { return iterator(std::begin(range), &tracker); }
+        iterator end() { return iterator(std::end(range), &tracker); }
+
+        ProgressTracker& Tracker() { return tracker; }
+
+    private:
+        static size_t SizeOf(Range& r) {
+            if constexpr (detail::HasSize<Range>::value) {
+                return static_cast<size_t>(std::size(r));
+            }
+            else {
+                return 0;
+            }
+        }
+
+        Range range; // reference for lvalues, owned copy for temporaries
+        ProgressTracker tracker;
+    };
+
+    // Wraps a range so that iterating it draws a progress bar with rate and
+    // ETA, e.g. `for (auto& file : CLIKit::Track(files, "Copying")) { ... }`.
+    // The bar is finished (and a newline printed) when the loop ends.
+    template<typename Range>
+    TrackedRange<Range> Track(Range&& range,
+        const std::string& label = "",
+        int barWidth = 40,
+        int redrawIntervalMs = 100)
+    {
+        return TrackedRange<Range>(std::forward<Range>(range), label, barWidth, redrawIntervalMs);
+    }
+}
@@ -0,0 +1,344 @@
+#pragma once
+// Session recording: SessionRecorder writes std::cout output and PollKey
+// input to an asciicast v2 file, ReplayRecording plays one back.
+#include "CLIKit.h"
+#include "CLIKitJson.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace CLIKit {
+
+    class SessionRecorder;
+
+    namespace detail {
+        // Set while a SessionRecorder is running.
+        inline std::atomic<SessionRecorder*> activeRecorder{ nullptr };
+        inline void RecordKey(const KeyResult& kr);
+
+        // Reads a JSON string starting at the opening quote at `pos`.
+        // On success `pos` is moved past the closing quote.
+        inline bool ParseJsonString(const std::string& in, size_t& pos, std::string& out)
+        {
+            if (pos >= in.size() || in[pos] != '"') return false;
+            out.clear();
+            for (size_t i = pos + 1; i < in.size(); i++) {
+                char c = in[i];
+                if (c == '"') {
+                    pos = i + 1;
+                    return true;
+                }
+                if (c != '\\') {
+                    out.push_back(c);
+                    continue;
+                }
+                if (++i >= in.size()) return false;
+                switch (in[i]) {
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'u': {
+                    if (i + 4 >= in.size()) return false;
+                    unsigned long cp = std::strtoul(in.substr(i + 1, 4).c_str(), nullptr, 16);
+                    i += 4;
+                    // Combine a surrogate pair into one code point
+                    if (cp >= 0xD800 && cp <= 0xDBFF && i + 6 < in.size() && in[i + 1] == '\\' && in[i + 2] == 'u') {
+                        unsigned long low = std::strtoul(in.substr(i + 3, 4).c_str(), nullptr, 16);
+                        if (low >= 0xDC00 && low <= 0xDFFF) {
+                            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                            i += 6;
+                        }
+                    }
+                    // Encode as UTF-8
+                    if (cp < 0x80) {
+                        out.push_back(static_cast<char>(cp));
+                    }
+                    else if (cp < 0x800) {
+                        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+                        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                    }
+                    else if (cp < 0x10000) {
+                        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+                        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                    }
+                    else {
+                        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+                        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+                        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                    }
+                    break;
+                }
+                default: out.push_back(in[i]); break; // \" \\ \/
+                }
+            }
+            return false;
+        }
+
+        // True if the terminal turns "\n" into "\r\n" on output (ONLCR),
+        // which players expect to find in the recorded bytes.
+        inline bool OutputTranslatesNewlines()
+        {
+#ifdef _WIN32
+            return true; // stdout is in text mode, the CRT writes "\r\n"
+#else
+            termios tio;
+            return isatty(STDOUT_FILENO) && tcgetattr(STDOUT_FILENO, &tio) == 0
+                && (tio.c_oflag & OPOST) && (tio.c_oflag & ONLCR);
+#endif
+        }
+    }
+
+    // Records everything written to std::cout and every key read by PollKey
+    // into an asciicast v2 file. Output is captured by a tee on std::cout's
+    // stream buffer and cut into one event per flush; events are formatted
+    // into a memory buffer and written to disk by a background thread.
+    // Any thread may write to std::cout while recording, but the recorder
+    // should be started and stopped while no other thread is printing.
+    // Only one recorder can be active at a time.
+    class SessionRecorder
+    {
+    public:
+        explicit SessionRecorder(const std::string& path)
+            : start(std::chrono::steady_clock::now())
+        {
+            // Claim the slot before touching the file, so a rejected second
+            // recorder leaves an existing recording alone
+            SessionRecorder* expected = nullptr;
+            if (!detail::activeRecorder.compare_exchange_strong(expected, this)) {
+                return;
+            }
+            file.open(path, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                detail::activeRecorder.store(nullptr, std::memory_order_release);
+                return;
+            }
+            translateNewlines = detail::OutputTranslatesNewlines();
+
+            // Header line
+            std::string header = "{\"version\": 2, \"width\": " + std::to_string(GetTerminalWidth())
+                + ", \"height\": " + std::to_string(GetTerminalHeight())
+                + ", \"timestamp\": " + std::to_string(std::time(nullptr)) + "}\n";
+            file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+            running = true;
+            writer = std::thread([this] { WriterLoop(); });
+
+            tee.recorder = this;
+            tee.target = std::cout.rdbuf();
+            std::cout.flush();
+            std::cout.rdbuf(&tee);
+            detail::keyObserver.store(&detail::RecordKey, std::memory_order_release);
+        }
+
+        ~SessionRecorder() {
+            Stop();
+        }
+
+        SessionRecorder(const SessionRecorder&) = delete;
+        SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+        bool IsRecording() const {
+            return running;
+        }
+
+        // Restores std::cout, writes any pending events and closes the file.
+        void Stop() {
+            if (!running) return;
+
+            std::cout.flush();
+            std::cout.rdbuf(tee.target);
+            {
+                // Waits for writes that were already inside the tee
+                std::lock_guard<std::mutex> lock(teeMutex);
+                FlushOutput();
+            }
+            detail::keyObserver.store(nullptr, std::memory_order_release);
+            detail::activeRecorder.store(nullptr, std::memory_order_release);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                running = false;
+            }
+            wake.notify_one();
+            writer.join();
+            file.close();
+        }
+
+        void RecordOutput(const char* data, size_t size) {
+            AppendEvent('o', data, size);
+        }
+
+        void RecordInput(const char* data, size_t size) {
+            AppendEvent('i', data, size);
+        }
+
+    private:
+        // Forwards every byte to the real std::cout buffer and keeps a copy
+        // until the next flush, which becomes one output event. Both happen
+        // under one lock, so output from several threads is recorded in the
+        // order it reached the terminal.
+        struct TeeBuffer : std::streambuf
+        {
+            SessionRecorder* recorder = nullptr;
+            std::streambuf* target = nullptr;
+
+        protected:
+            int_type overflow(int_type ch) override {
+                if (traits_type::eq_int_type(ch, traits_type::eof())) {
+                    return traits_type::not_eof(ch);
+                }
+                std::lock_guard<std::mutex> lock(recorder->teeMutex);
+                recorder->pending.push_back(traits_type::to_char_type(ch));
+                return target->sputc(traits_type::to_char_type(ch));
+            }
+
+            std::streamsize xsputn(const char* s, std::streamsize n) override {
+                std::lock_guard<std::mutex> lock(recorder->teeMutex);
+                recorder->pending.append(s, static_cast<size_t>(n));
+                return target->sputn(s, n);
+            }
+
+            int sync() override {
+                std::lock_guard<std::mutex> lock(recorder->teeMutex);
+                recorder->FlushOutput();
+                return target->pubsync();
+            }
+        };
+
+        // Caller holds teeMutex.
+        void FlushOutput() {
+            if (pending.empty()) return;
+            RecordOutput(pending.data(), pending.size());
+            pending.clear();
+        }
+
+        void AppendEvent(char type, const char* data, size_t size) {
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            char prefix[48];
+            int prefixLen = std::snprintf(prefix, sizeof(prefix), "[%.6f, \"%c\", \"", elapsed, type);
+
+            bool wakeWriter;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                front.append(prefix, static_cast<size_t>(prefixLen));
+                detail::AppendJsonEscaped(front, data, size, type == 'o' && translateNewlines);
+                front.append("\"]\n");
+                wakeWriter = front.size() >= kWriteThreshold;
+            }
+            if (wakeWriter) {
+                wake.notify_one();
+            }
+        }
+
+        void WriterLoop() {
+            std::string back;
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                // Write at least every interval, sooner if the buffer fills up
+                wake.wait_for(lock, std::chrono::milliseconds(kWriteIntervalMs),
+                    [this] { return !running || front.size() >= kWriteThreshold; });
+
+                back.swap(front);
+                bool stopping = !running;
+                lock.unlock();
+
+                if (!back.empty()) {
+                    file.write(back.data(), static_cast<std::streamsize>(back.size()));
+                    file.flush();
+                    back.clear();
+                }
+                if (stopping) return;
+                lock.lock();
+            }
+        }
+
+        static constexpr size_t kWriteThreshold = 64 * 1024;
+        static constexpr int kWriteIntervalMs = 250;
+
+        std::ofstream file;
+        std::chrono::steady_clock::time_point start;
+        TeeBuffer tee;
+        std::mutex teeMutex;  // guards pending and writes through the tee
+        std::string pending;  // output since the last flush
+        std::string front;    // formatted events waiting for the writer
+        std::mutex mutex;     // guards front and running
+        bool translateNewlines = false;
+        std::condition_variable wake;
+        std::thread writer;
+        bool running = false;
+    };
+
+    namespace detail {
+        inline void RecordKey(const KeyResult& kr)
+        {
+            SessionRecorder* recorder = activeRecorder.load(std::memory_order_acquire);
+            if (!recorder) return;
+
+            // Store the bytes the terminal would have sent for this key
+            const char* bytes = nullptr;
+            char ch[1] = { kr.ch };
+            switch (kr.key) {
+            case Key::Char:       recorder->RecordInput(ch, 1); return;
+            case Key::Space:      bytes = " "; break;
+            case Key::Enter:      bytes = "\r"; break;
+            case Key::Backspace:  bytes = "\x7f"; break;
+            case Key::Escape:     bytes = "\033"; break;
+            case Key::UpArrow:    bytes = "\033[A"; break;
+            case Key::DownArrow:  bytes = "\033[B"; break;
+            case Key::RightArrow: bytes = "\033[C"; break;
+            case Key::LeftArrow:  bytes = "\033[D"; break;
+            default: return;
+            }
+            recorder->RecordInput(bytes, std::strlen(bytes));
+        }
+    }
+
+    // Plays back an asciicast v2 recording through std::cout.
+    // `speed` scales playback (2.0 = twice as fast); gaps longer than
+    // `maxIdleSeconds` are shortened to it (0 = keep original timing).
+    inline bool ReplayRecording(const std::string& path, double speed = 1.0, double maxIdleSeconds = 0.0)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::string line;
+        if (!file || !std::getline(file, line) || line.find("\"version\"") == std::string::npos) {
+            return false;
+        }
+        if (speed <= 0.0) speed = 1.0;
+
+        std::string type, data;
+        double previous = 0.0;
+        while (std::getline(file, line)) {
+            // Event line: [time, "type", "data"]
+            size_t pos = line.find('[');
+            if (pos == std::string::npos) continue;
+            char* numberEnd = nullptr;
+            double time = std::strtod(line.c_str() + pos + 1, &numberEnd);
+            pos = line.find('"', static_cast<size_t>(numberEnd - line.c_str()));
+            if (pos == std::string::npos || !detail::ParseJsonString(line, pos, type)) continue;
+            pos = line.find('"', pos);
+            if (pos == std::string::npos || !detail::ParseJsonString(line, pos, data)) continue;
+
+            double delay = time - previous;
+            previous = time;
+            if (maxIdleSeconds > 0.0 && delay > maxIdleSeconds) delay = maxIdleSeconds;
+            if (delay > 0.0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(delay / speed));
+            }
+
+            if (type == "o") {
+                std::cout.write(data.data(), static_cast<std::streamsize>(data.size()));
+                std::cout.flush();
+            }
+        }
+        return true;
+    }
+}
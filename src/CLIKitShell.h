@@ -0,0 +1,572 @@
+#pragma once
+// Interactive command shell with trie dispatch, history and asynchronous
+// tab completion.
+#include "CLIKit.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace CLIKit {
+
+    // Colors used by Shell for its prompt and completion menus.
+    struct ShellStyle
+    {
+        std::string prompt = Color::LIGHT_GREEN;
+        std::string candidate = Color::LIGHT_CYAN;
+        std::string description = Color::GRAY;
+        std::string hint = Color::GRAY;
+    };
+
+    // Interactive command shell with line editing, history and tab completion.
+    // Command names (which may contain spaces, e.g. "user add") live in a
+    // character trie, so dispatch and name completion cost depends on the
+    // length of the input, not on how many commands are registered.
+    //
+    // Argument completers run on one background worker thread. A query
+    // starts as soon as the user is typing an argument, is cancelled when the
+    // input moves on to something it no longer covers, and its results are
+    // cached. Only the latest query waits for the worker; older ones are
+    // dropped before they start.
+    // Typing more characters refines cached results locally instead of
+    // asking the completer again.
+    class Shell
+    {
+    public:
+        using Handler = std::function<void(const std::vector<std::string>& args)>;
+
+        // Returns candidates that start with `prefix`. Called on a background
+        // thread; long-running completers should return once `cancelled` is set.
+        using Completer = std::function<std::vector<std::string>(const std::string& prefix, const std::atomic<bool>& cancelled)>;
+
+        struct Completion
+        {
+            std::vector<std::string> candidates;
+            std::vector<std::string> descriptions; // parallel to candidates, for command names
+            size_t replaceFrom = 0;                // where in the line the completed text starts
+            bool pending = false;                  // completer still running
+        };
+
+        explicit Shell(const std::string& prompt = "> ", const ShellStyle& style = ShellStyle())
+            : prompt(prompt), style(style)
+        {
+            nodes.emplace_back(); // root
+            AddCommand("help", [this](const std::vector<std::string>&) { PrintHelp(); }, "List available commands");
+            AddCommand("exit", [this](const std::vector<std::string>&) { Stop(); }, "Leave the shell");
+        }
+
+        ~Shell() {
+            StopWorker();
+        }
+
+        Shell(const Shell&) = delete;
+        Shell& operator=(const Shell&) = delete;
+
+        // `argCompleters[i]` completes the i-th argument. Registering an
+        // existing name replaces it.
+        void AddCommand(const std::string& name,
+            Handler handler,
+            const std::string& help = "",
+            std::vector<Completer> argCompleters = {})
+        {
+            int node = 0;
+            for (char c : name) {
+                int child = Child(node, c);
+                if (child < 0) child = AddChild(node, c);
+                node = child;
+            }
+
+            Command command{ name, help, std::move(handler), std::move(argCompleters) };
+            if (nodes[node].command >= 0) {
+                commands[nodes[node].command] = std::move(command);
+            }
+            else {
+                nodes[node].command = static_cast<int>(commands.size());
+                commands.push_back(std::move(command));
+            }
+            cache.clear();
+        }
+
+        // Runs the command in `line`. Returns false if no command matched.
+        bool Execute(const std::string& line)
+        {
+            std::vector<std::string> tokens = Tokenize(line);
+            if (tokens.empty()) return true;
+
+            size_t used = 0;
+            int command = MatchCommand(tokens, tokens.size(), used);
+            if (command < 0) {
+                PrintError("Unknown command: " + tokens[0] + " (type 'help' for a list)");
+                return false;
+            }
+
+            std::vector<std::string> args(tokens.begin() + used, tokens.end());
+            commands[command].handler(args);
+            return true;
+        }
+
+        // Reads commands until "exit", end of input or Stop().
+        void Run()
+        {
+            running = true;
+            while (running) {
+                std::optional<std::string> line = ReadLine();
+                if (!line) break;
+                try {
+                    Execute(*line);
+                }
+                catch (const std::exception& e) {
+                    PrintError(e.what());
+                }
+            }
+            StopWorker();
+        }
+
+        void Stop() {
+            running = false;
+        }
+
+        // Reads one line with editing, history (up/down) and tab completion.
+        // Returns std::nullopt at end of input (Ctrl+D on an empty line).
+        std::optional<std::string> ReadLine()
+        {
+            std::string line;
+            size_t historyIndex = history.size();
+            DrawLine(line);
+
+            while (true) {
+                KeyResult kr = PollKey();
+                bool edited = false;
+
+                switch (kr.key) {
+                case Key::Enter:
+                    std::cout << "\n" << std::flush;
+                    if (!line.empty() && (history.empty() || history.back() != line)) {
+                        history.push_back(line);
+                    }
+                    return line;
+                case Key::Char:
+                    if (kr.ch == '\t') {
+                        TabComplete(line);
+                    }
+                    else if (kr.ch == static_cast<char>(EOF) || (kr.ch == 4 && line.empty())) {
+                        std::cout << "\n" << std::flush;
+                        return std::nullopt;
+                    }
+                    else if (static_cast<unsigned char>(kr.ch) >= 32) {
+                        line.push_back(kr.ch);
+                        edited = true;
+                    }
+                    break;
+                case Key::Space:
+                    line.push_back(' ');
+                    edited = true;
+                    break;
+                case Key::Backspace:
+                    if (!line.empty()) {
+                        line.pop_back();
+                        edited = true;
+                    }
+                    break;
+                case Key::Escape:
+                    line.clear();
+                    edited = true;
+                    break;
+                case Key::UpArrow:
+                    if (historyIndex > 0) {
+                        line = history[--historyIndex];
+                        edited = true;
+                    }
+                    break;
+                case Key::DownArrow:
+                    if (historyIndex < history.size()) {
+                        historyIndex++;
+                        line = historyIndex < history.size() ? history[historyIndex] : "";
+                        edited = true;
+                    }
+                    break;
+                default:
+                    break;
+                }
+
+                if (edited) {
+                    DrawLine(line);
+                    // Start (or cancel) the background query for what is being typed
+                    Complete(line, 0);
+                }
+            }
+        }
+
+        // Computes completions for the end of `line`. Waits up to `waitMs`
+        // for a background completer (-1 = until it finishes).
+        Completion Complete(const std::string& line, int waitMs = -1)
+        {
+            Completion result;
+            std::vector<std::string> tokens = Tokenize(line);
+            bool endsWithSpace = !line.empty() && std::isspace(static_cast<unsigned char>(line.back()));
+            std::string word = (endsWithSpace || tokens.empty()) ? "" : tokens.back();
+            size_t completed = (endsWithSpace || tokens.empty()) ? tokens.size() : tokens.size() - 1;
+
+            // Still typing a command name?
+            std::string namePrefix;
+            for (size_t i = 0; i < completed; i++) namePrefix += tokens[i] + " ";
+            namePrefix += word;
+            int node = Find(namePrefix);
+            if (node >= 0) {
+                CollectCommands(node, result);
+                if (!result.candidates.empty()) {
+                    CancelPending();
+                    return result;
+                }
+            }
+
+            // Otherwise complete an argument of the matched command
+            size_t used = 0;
+            int command = MatchCommand(tokens, completed, used);
+            size_t argIndex = completed - used;
+            if (command < 0 || argIndex >= commands[command].completers.size()) {
+                CancelPending();
+                return result;
+            }
+            result.replaceFrom = line.size() - word.size();
+
+            std::string base = std::to_string(command) + '\x1f' + std::to_string(argIndex) + '\x1f';
+            if (const std::vector<std::string>* cached = FindCached(base, word)) {
+                result.candidates = *cached;
+                return result;
+            }
+
+            // Keep a running query if its (shorter) prefix still covers this word
+            if (pending && !(pending->base == base && word.compare(0, pending->prefix.size(), pending->prefix) == 0)) {
+                CancelPending();
+            }
+            if (!pending) {
+                StartQuery(base, word, commands[command].completers[argIndex]);
+            }
+
+            if (waitMs < 0) {
+                pending->result.wait();
+            }
+            else if (pending->result.wait_for(std::chrono::milliseconds(waitMs)) != std::future_status::ready) {
+                result.pending = true;
+                return result;
+            }
+
+            std::vector<std::string> found;
+            try {
+                found = pending->result.get();
+            }
+            catch (...) {
+                // A failing completer just offers nothing
+            }
+            std::string queriedPrefix = pending->prefix;
+            pending.reset();
+
+            if (cache.size() > kMaxCacheEntries) cache.clear();
+            cache[base + queriedPrefix] = std::move(found);
+            if (const std::vector<std::string>* cached = FindCached(base, word)) {
+                result.candidates = *cached;
+            }
+            return result;
+        }
+
+        // Milliseconds Tab waits for a completer before showing a hint.
+        int completionWaitMs = 150;
+
+    private:
+        struct Node
+        {
+            std::vector<std::pair<char, int>> children; // sorted by char
+            int command = -1;
+        };
+
+        struct Command
+        {
+            std::string name;
+            std::string help;
+            Handler handler;
+            std::vector<Completer> completers;
+        };
+
+        struct PendingQuery
+        {
+            std::string base;   // command/argument part of the cache key
+            std::string prefix;
+            std::shared_ptr<std::atomic<bool>> cancelled;
+            std::future<std::vector<std::string>> result;
+        };
+
+        struct Job
+        {
+            Completer completer;
+            std::string prefix;
+            std::shared_ptr<std::atomic<bool>> cancelled;
+            std::promise<std::vector<std::string>> promise;
+        };
+
+        static constexpr size_t kMaxCandidates = 200;
+        static constexpr size_t kMaxCacheEntries = 512;
+
+        int Child(int node, char c) const {
+            const auto& children = nodes[node].children;
+            auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(c, -1));
+            return (it != children.end() && it->first == c) ? it->second : -1;
+        }
+
+        int AddChild(int node, char c) {
+            int child = static_cast<int>(nodes.size());
+            nodes.emplace_back();
+            auto& children = nodes[node].children;
+            children.insert(std::lower_bound(children.begin(), children.end(), std::make_pair(c, -1)), { c, child });
+            return child;
+        }
+
+        int Find(const std::string& prefix) const {
+            int node = 0;
+            for (char c : prefix) {
+                node = Child(node, c);
+                if (node < 0) return -1;
+            }
+            return node;
+        }
+
+        // Longest command made of whole tokens from the first `count` tokens.
+        int MatchCommand(const std::vector<std::string>& tokens, size_t count, size_t& used) const {
+            int best = -1;
+            int node = 0;
+            for (size_t t = 0; t < count && node >= 0; t++) {
+                if (t > 0) node = Child(node, ' ');
+                for (size_t i = 0; i < tokens[t].size() && node >= 0; i++) {
+                    node = Child(node, tokens[t][i]);
+                }
+                if (node >= 0 && nodes[node].command >= 0) {
+                    best = nodes[node].command;
+                    used = t + 1;
+                }
+            }
+            return best;
+        }
+
+        // Commands below `node`, in alphabetical order, up to `limit`.
+        void CollectCommands(int node, Completion& out, size_t limit = kMaxCandidates) const {
+            if (out.candidates.size() >= limit) return;
+            if (nodes[node].command >= 0) {
+                const Command& command = commands[nodes[node].command];
+                out.candidates.push_back(command.name);
+                out.descriptions.push_back(command.help);
+            }
+            for (const auto& child : nodes[node].children) {
+                CollectCommands(child.second, out, limit);
+            }
+        }
+
+        // Looks for results for `word` or, failing that, for a shorter prefix
+        // of it that can be filtered down (and is then cached as well).
+        const std::vector<std::string>* FindCached(const std::string& base, const std::string& word) {
+            for (size_t len = word.size() + 1; len-- > 0;) {
+                auto it = cache.find(base + word.substr(0, len));
+                if (it == cache.end()) continue;
+                if (len == word.size()) return &it->second;
+
+                std::vector<std::string> filtered;
+                for (const auto& candidate : it->second) {
+                    if (candidate.compare(0, word.size(), word) == 0) filtered.push_back(candidate);
+                }
+                if (cache.size() > kMaxCacheEntries) cache.clear();
+                return &(cache[base + word] = std::move(filtered));
+            }
+            return nullptr;
+        }
+
+        void StartQuery(const std::string& base, const std::string& prefix, const Completer& completer) {
+            auto cancelled = std::make_shared<std::atomic<bool>>(false);
+            Job next{ completer, prefix, cancelled, {} };
+            pending = PendingQuery{ base, prefix, cancelled, next.promise.get_future() };
+
+            if (!worker.joinable()) {
+                worker = std::thread([this] { WorkerLoop(); });
+            }
+            {
+                // Replaces a queued job that has not started yet
+                std::lock_guard<std::mutex> lock(workerMutex);
+                job = std::move(next);
+            }
+            workerReady.notify_one();
+        }
+
+        void CancelPending() {
+            if (!pending) return;
+            pending->cancelled->store(true);
+            pending.reset();
+        }
+
+        // Cancels the current query and waits for the worker to return.
+        void StopWorker() {
+            CancelPending();
+            if (!worker.joinable()) return;
+            {
+                std::lock_guard<std::mutex> lock(workerMutex);
+                stopping = true;
+                job.reset();
+            }
+            workerReady.notify_one();
+            worker.join();
+            stopping = false;
+        }
+
+        void WorkerLoop() {
+            while (true) {
+                Job current;
+                {
+                    std::unique_lock<std::mutex> lock(workerMutex);
+                    workerReady.wait(lock, [this] { return job || stopping; });
+                    if (stopping) return;
+                    current = std::move(*job);
+                    job.reset();
+                }
+                if (current.cancelled->load()) continue;
+                try {
+                    current.promise.set_value(current.completer(current.prefix, *current.cancelled));
+                }
+                catch (...) {
+                    current.promise.set_exception(std::current_exception());
+                }
+            }
+        }
+
+        void DrawLine(const std::string& line, const std::string& hint = "") {
+            std::string out = "\r" + style.prompt + prompt + Color::RESET + line;
+            if (!hint.empty()) {
+                // Show the hint after the input, then put the cursor back
+                out += " " + style.hint + hint + Color::RESET + "\033[K\033[" + std::to_string(hint.size() + 1) + "D";
+            }
+            else {
+                out += "\033[K";
+            }
+            std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+            std::cout.flush();
+        }
+
+        void TabComplete(std::string& line) {
+            Completion completion = Complete(line, completionWaitMs);
+            if (completion.pending) {
+                DrawLine(line, "(loading completions...)");
+                return;
+            }
+            if (completion.candidates.empty()) {
+                std::cout << "\a" << std::flush;
+                return;
+            }
+
+            std::string word = line.substr(completion.replaceFrom);
+            if (completion.candidates.size() == 1) {
+                line = line.substr(0, completion.replaceFrom) + completion.candidates[0] + " ";
+                DrawLine(line);
+                return;
+            }
+
+            // Extend to the longest common prefix first, list on the next Tab
+            std::string common = completion.candidates[0];
+            for (const auto& candidate : completion.candidates) {
+                size_t n = 0;
+                while (n < common.size() && n < candidate.size() && common[n] == candidate[n]) n++;
+                common.resize(n);
+            }
+            if (common.size() > word.size()) {
+                line = line.substr(0, completion.replaceFrom) + common;
+                DrawLine(line);
+                return;
+            }
+
+            PrintMenu(completion);
+            DrawLine(line);
+        }
+
+        void PrintMenu(const Completion& completion) const {
+            std::string out = "\n";
+            bool described = false;
+            size_t widest = 0;
+            for (size_t i = 0; i < completion.candidates.size(); i++) {
+                widest = std::max(widest, completion.candidates[i].size());
+                if (i < completion.descriptions.size() && !completion.descriptions[i].empty()) described = true;
+            }
+
+            if (described) {
+                // One command per line with its help text
+                for (size_t i = 0; i < completion.candidates.size(); i++) {
+                    out += "  " + style.candidate + completion.candidates[i] + Color::RESET;
+                    out += std::string(widest - completion.candidates[i].size() + 2, ' ');
+                    out += style.description + completion.descriptions[i] + Color::RESET + "\n";
+                }
+            }
+            else {
+                // Columns, like a shell
+                size_t cell = widest + 2;
+                size_t columns = std::max<size_t>(1, static_cast<size_t>(GetTerminalWidth()) / cell);
+                for (size_t i = 0; i < completion.candidates.size(); i++) {
+                    out += style.candidate + completion.candidates[i] + Color::RESET;
+                    bool endOfRow = (i + 1) % columns == 0 || i + 1 == completion.candidates.size();
+                    out += endOfRow ? std::string("\n") : std::string(cell - completion.candidates[i].size(), ' ');
+                }
+            }
+            std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+        }
+
+        void PrintHelp() const {
+            // Help lists everything; only the completion menu is capped
+            Completion all;
+            all.candidates.reserve(commands.size());
+            all.descriptions.reserve(commands.size());
+            CollectCommands(0, all, std::numeric_limits<size_t>::max());
+            PrintMenu(all);
+        }
+
+        static std::vector<std::string> Tokenize(const std::string& line) {
+            std::vector<std::string> tokens;
+            std::string current;
+            bool inToken = false;
+            bool quoted = false;
+            for (char c : line) {
+                if (c == '"') {
+                    quoted = !quoted;
+                    inToken = true;
+                }
+                else if (!quoted && std::isspace(static_cast<unsigned char>(c))) {
+                    if (inToken) tokens.push_back(std::move(current));
+                    current.clear();
+                    inToken = false;
+                }
+                else {
+                    current.push_back(c);
+                    inToken = true;
+                }
+            }
+            if (inToken) tokens.push_back(std::move(current));
+            return tokens;
+        }
+
+        std::string prompt;
+        ShellStyle style;
+        std::vector<Node> nodes;
+        std::vector<Command> commands;
+        std::vector<std::string> history;
+        std::unordered_map<std::string, std::vector<std::string>> cache;
+        std::optional<PendingQuery> pending;
+        bool running = false;
+
+        // Completer worker; `job` and `stopping` are guarded by workerMutex
+        std::thread worker;
+        std::mutex workerMutex;
+        std::condition_variable workerReady;
+        std::optional<Job> job;
+        bool stopping = false;
+    };
+}